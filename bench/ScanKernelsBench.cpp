@@ -0,0 +1,127 @@
+#include <Interfaces/ScanKernels.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+using warehouseInterface::ScanKernels;
+using Kernel = ScanKernels::Kernel;
+
+/**
+ * @brief Columns of a department holding one million products, none of them matching the benchmark filters, so every
+ * scan runs to the last row.
+ */
+struct Department
+{
+    static constexpr std::size_t rows = 1'000'000;
+
+    std::vector<warehouseInterface::ProductClassId> classes = std::vector<warehouseInterface::ProductClassId>(rows);
+    std::vector<warehouseInterface::NameSymbol> names = std::vector<warehouseInterface::NameSymbol>(rows);
+    std::vector<float> sizes = std::vector<float>(rows);
+    std::vector<warehouseInterface::ProductLabelFlags> flags = std::vector<warehouseInterface::ProductLabelFlags>(rows);
+    std::vector<std::uint8_t> reserved = std::vector<std::uint8_t>(rows);
+
+    Department()
+    {
+        std::mt19937 random{42};
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            classes[row] = static_cast<warehouseInterface::ProductClassId>(random() % 7);
+            names[row] = static_cast<warehouseInterface::NameSymbol>(random() % 5000);
+            sizes[row] = static_cast<float>(random() % 100) / 4.0f;
+            flags[row] = static_cast<warehouseInterface::ProductLabelFlags>(random() % 128);
+            reserved[row] = random() % 10 == 0;
+        }
+    }
+
+    warehouseInterface::ColumnsView columns() const
+    {
+        return {classes.data(), names.data(), sizes.data(), flags.data(), reserved.data()};
+    }
+};
+
+const char *kernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+        case Kernel::avx2:
+            return "avx2";
+        case Kernel::sse42:
+            return "sse42";
+        case Kernel::scalar:
+            break;
+    }
+    return "scalar";
+}
+
+/**
+ * @brief Runs the full scan repeatedly with the kernel.
+ * @return The median time of one scan in milliseconds.
+ */
+double medianScanTime(const Department &department, const warehouseInterface::RowFilter &filter, Kernel kernel,
+                      int repetitions)
+{
+    std::vector<double> times{};
+    std::size_t found = 0;
+    for (int repetition = 0; repetition < repetitions; ++repetition)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        found += ScanKernels::findFirst(department.columns(), 0, Department::rows, filter, kernel);
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    if (found != Department::rows * static_cast<std::size_t>(repetitions))
+    {
+        std::fprintf(stderr, "%s kernel found an unexpected row\n", kernelName(kernel));
+        std::exit(EXIT_FAILURE);
+    }
+    std::nth_element(times.begin(), times.begin() + repetitions / 2, times.end());
+    return times[static_cast<std::size_t>(repetitions / 2)];
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    const auto repetitions = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 50;
+    const Department department{};
+
+    warehouseInterface::RowFilter byName{};
+    byName.name = 5000;
+    warehouseInterface::RowFilter byClassAndFlags{};
+    byClassAndFlags.productClass = 3;
+    byClassAndFlags.requiredFlags = 1U << 7;
+    warehouseInterface::RowFilter bySize{};
+    bySize.minSize = 30.0f;
+    bySize.maxSize = 40.0f;
+    const struct
+    {
+        const char *name;
+        warehouseInterface::RowFilter filter;
+    } scans[] = {{"name", byName}, {"class+flags", byClassAndFlags}, {"size range", bySize}};
+
+    std::printf("best kernel supported by the CPU: %s\n", kernelName(ScanKernels::best()));
+    std::printf("%-12s %-8s %12s %14s\n", "filter", "kernel", "median ms", "Mrows/s");
+    for (const auto &scan : scans)
+    {
+        for (const auto kernel : {Kernel::scalar, Kernel::sse42, Kernel::avx2})
+        {
+            // findFirst falls back to another kernel if the CPU does not support the requested one.
+            if (kernel > ScanKernels::best())
+            {
+                continue;
+            }
+            const auto milliseconds = medianScanTime(department, scan.filter, kernel, repetitions);
+            std::printf("%-12s %-8s %12.3f %14.1f\n", scan.name, kernelName(kernel), milliseconds,
+                        static_cast<double>(Department::rows) / milliseconds / 1000.0);
+        }
+    }
+    return EXIT_SUCCESS;
+}
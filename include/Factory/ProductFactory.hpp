@@ -1,15 +1,147 @@
 #pragma once
+#include <Interfaces/ColumnarStorage.hpp>
 #include <Interfaces/IProduct.hpp>
 #include <MagicEnum/magic_enum.hpp>
 #include <Products/BasicProduct.hpp>
+#include <Products/ProductValue.hpp>
 #include <Products/ProductsList.hpp>
+#include <cassert>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
 
 namespace warehouse
 {
 class ProductFactory
 {
     // student code begin
+public:
+    using ProductCreator = std::function<warehouseInterface::IProductPtr(const std::string &, float)>;
+    using ValueCreator = std::function<ProductValue(const std::string &, float)>;
+
+    ProductFactory()
+    {
+        registerProduct<AcetoneBarrel>("AcetoneBarrel");
+        registerProduct<AstronautsIceCream>("AstronautsIceCream");
+        registerProduct<ElectronicParts>("ElectronicParts");
+        registerProduct<ExplosiveBarrel>("ExplosiveBarrel");
+        registerProduct<GlassWare>("GlassWare");
+        registerProduct<IndustrialServerRack>("IndustrialServerRack");
+        registerProduct<TV>("TV");
+    }
+
+    /**
+     * @brief Registers a product class which can be created by the factory and assigns it a class ID. The built-in classes
+     * are registered in the order of Products/ProductsList.hpp. Products of the class are allocated from the ProductArena
+     * bucket of its size, and the creator is registered as the ColumnarStorage builder of the class. The class descriptor is
+     * built once from a sample product of size 0 and shared by all products of the class, so the product flags must not
+     * depend on the instance (checked in debug builds).
+     * @return The class ID assigned to the product class.
+     */
+    template <typename Product>
+    warehouseInterface::ProductClassId registerProduct(const std::string &className)
+    {
+        static_assert(alignof(Product) <= warehouseInterface::SlabBucket::blockAlignment);
+        const auto classId = warehouseInterface::ProductClassTable::instance().intern(className);
+        const Product sample(className, 0.0f);
+        auto &descriptors = warehouseInterface::ProductClassDescriptors::instance();
+        const auto &descriptor = descriptors.describe(classId, sample.itemFlags(), sample.asJson());
+        auto &bucket = warehouseInterface::ProductArena::instance().bucket(sizeof(Product));
+        creators_[className] = [&descriptor, &bucket](const std::string &name,
+                                                      float size) -> warehouseInterface::IProductPtr {
+            auto *block = bucket.allocate();
+            Product *created{};
+            try
+            {
+                created = ::new (block) Product(name, size);
+            }
+            catch (...)
+            {
+                bucket.deallocate(block);
+                throw;
+            }
+            warehouseInterface::IProductPtr product{created, warehouseInterface::ProductDeleter{bucket}};
+            assert(product->itemFlags() == descriptor.flags && "product flags differ from the flags of its class");
+            ProductIdentity::assign(*product, descriptor, name);
+            return product;
+        };
+        warehouseInterface::ColumnarStorage::registerBuilder(classId, creators_[className]);
+        if constexpr (ProductValue::holds<Product>)
+        {
+            valueCreators_[className] = [&descriptor](const std::string &name, float size) {
+                Product product(name, size);
+                ProductIdentity::assign(product, descriptor, name);
+                return ProductValue{std::move(product)};
+            };
+        }
+        return classId;
+    }
+
+    /**
+     * @brief Gets the ID of a registered product class.
+     * @return The class ID, or anyProductClass if the class is unknown.
+     */
+    static warehouseInterface::ProductClassId classId(const std::string &className)
+    {
+        return warehouseInterface::ProductClassTable::instance().find(className);
+    }
+
+    /**
+     * @brief Gets the name of a registered product class.
+     * @return The class name.
+     */
+    static std::string className(warehouseInterface::ProductClassId classId)
+    {
+        return warehouseInterface::ProductClassTable::instance().name(classId);
+    }
+
+    /**
+     * @brief Creates a product of the requested class.
+     * @return A valid product pointer. Throws std::runtime_error if the product class is unknown.
+     */
+    warehouseInterface::IProductPtr createProduct(const std::string &className, const std::string &name, float size) const
+    {
+        const auto creator = creators_.find(className);
+        if (creator == creators_.end())
+        {
+            throw std::runtime_error("Unknown product class: " + className);
+        }
+        return creator->second(name, size);
+    }
+
+    /**
+     * @brief Creates a product of a built-in class as a value.
+     * @return The product value. Throws std::runtime_error if the product class is not a built-in one.
+     */
+    ProductValue createValue(const std::string &className, const std::string &name, float size) const
+    {
+        const auto creator = valueCreators_.find(className);
+        if (creator == valueCreators_.end())
+        {
+            throw std::runtime_error("Unknown product value class: " + className);
+        }
+        return creator->second(name, size);
+    }
+
+private:
+    /**
+     * @brief Reaches the protected IProduct::assignIdentity of the created products.
+     */
+    struct ProductIdentity : warehouseInterface::IProduct
+    {
+        static void assign(warehouseInterface::IProduct &product,
+                           const warehouseInterface::ProductClassDescriptor &descriptor, const std::string &name)
+        {
+            const auto assignIdentity = &ProductIdentity::assignIdentity;
+            (product.*assignIdentity)(descriptor, warehouseInterface::NamePool::instance().intern(name));
+        }
+    };
+
+    std::unordered_map<std::string, ProductCreator> creators_{};
+    std::unordered_map<std::string, ValueCreator> valueCreators_{};
     // student code end
 };
 
-}  // namespace warehouse
\ No newline at end of file
+}  // namespace warehouse
@@ -0,0 +1,459 @@
+#pragma once
+#include <Interfaces/IProduct.hpp>
+#include <Interfaces/OccupancyCounter.hpp>
+#include <Interfaces/ProductClassDescriptor.hpp>
+#include <Interfaces/ProductIndex.hpp>
+#include <Interfaces/ScanKernels.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Department product storage as parallel arrays (struct of arrays): class ID, name symbol, size and flags of every
+ * stored product, in insertion order. Lookups, occupancy sums and serialization are linear passes over a few dense
+ * columns instead of pointer chasing, and lookups are vectorized by the ScanKernels. A product object is only
+ * materialized when it leaves the storage: products of the classes with a registered builder (every class registered in
+ * the ProductFactory) are rebuilt from their class, name and size, and the objects of other classes are kept aside as
+ * they are. Removed rows become tombstones skipped by all passes, and the columns are compacted once half of the rows
+ * are dead, so removing a product costs amortized constant time wherever it is stored.
+ */
+class ColumnarStorage
+{
+public:
+    /**
+     * @brief Rebuilds a product of a class from its name and size.
+     */
+    using Builder = std::function<IProductPtr(const std::string &, float)>;
+
+private:
+    /**
+     * @brief Process-wide builders, indexed by class ID.
+     */
+    struct Builders
+    {
+        std::shared_mutex mutex{};
+        std::vector<Builder> byClass{};
+    };
+
+    std::vector<ProductClassId> classes_{};
+    std::vector<NameSymbol> names_{};
+    std::vector<float> sizes_{};
+    std::vector<ProductLabelFlags> flags_{};
+    std::vector<std::uint64_t> rows_{};
+    std::vector<std::uint8_t> reserved_{};
+    std::size_t first_{0};
+    std::size_t removed_{0};
+    std::unordered_map<std::uint64_t, IProductPtr> kept_{};
+
+public:
+    ColumnarStorage() = default;
+    ColumnarStorage(const ColumnarStorage &) = delete;
+    ColumnarStorage &operator=(const ColumnarStorage &) = delete;
+
+    /**
+     * @brief Registers how products of the class are rebuilt when they leave a columnar storage.
+     * @return None.
+     */
+    static void registerBuilder(ProductClassId productClass, Builder builder)
+    {
+        auto &builders = buildersTable();
+        std::unique_lock lock{builders.mutex};
+        if (productClass >= builders.byClass.size())
+        {
+            builders.byClass.resize(productClass + 1);
+        }
+        builders.byClass[productClass] = std::move(builder);
+    }
+
+    /**
+     * @brief Stores the product at the end of the storage. The object is released if its class has a builder.
+     * @return None.
+     */
+    void insert(IProductPtr product)
+    {
+        const auto key = ProductIndex::keyOf(*product);
+        const auto row = nextRow.fetch_add(1, std::memory_order_relaxed);
+        classes_.push_back(key.productClass);
+        names_.push_back(key.name);
+        sizes_.push_back(product->itemSize());
+        flags_.push_back(product->itemFlags());
+        rows_.push_back(row);
+        reserved_.push_back(rowStored);
+        if (!hasBuilder(key.productClass))
+        {
+            kept_.emplace(row, std::move(product));
+        }
+    }
+
+    /**
+     * @brief Removes the first stored product matching the class and the name. The anyProductClass class or the anyName
+     * name is not considered in the matching.
+     * @return A valid pointer if a matching product is stored, nullptr otherwise.
+     */
+    IProductPtr extract(ProductClassId productClass, NameSymbol name)
+    {
+        return take(firstMatch(productClass, name));
+    }
+
+    /**
+     * @brief Removes the first stored product meeting the filter, which may also test the product flags and size.
+     * @return A valid pointer if a matching product is stored, nullptr otherwise.
+     */
+    IProductPtr extract(const RowFilter &filter)
+    {
+        return take(findFirst(filter));
+    }
+
+    /**
+     * @brief Removes the oldest stored product if it matches the class and the name (queue access).
+     * @return A valid pointer if the oldest product matches, nullptr otherwise.
+     */
+    IProductPtr extractFront(ProductClassId productClass, NameSymbol name)
+    {
+        return take(frontMatch(productClass, name));
+    }
+
+    /**
+     * @brief Removes the newest stored product if it matches the class and the name (stack access).
+     * @return A valid pointer if the newest product matches, nullptr otherwise.
+     */
+    IProductPtr extractBack(ProductClassId productClass, NameSymbol name)
+    {
+        return take(backMatch(productClass, name));
+    }
+
+    ProductIndex::Reservation reserve(ProductClassId productClass, NameSymbol name)
+    {
+        return mark(firstMatch(productClass, name));
+    }
+
+    ProductIndex::Reservation reserveFront(ProductClassId productClass, NameSymbol name)
+    {
+        return mark(frontMatch(productClass, name));
+    }
+
+    ProductIndex::Reservation reserveBack(ProductClassId productClass, NameSymbol name)
+    {
+        return mark(backMatch(productClass, name));
+    }
+
+    /**
+     * @brief Removes the reserved product.
+     * @return The removed product, nullptr if the reservation is empty.
+     */
+    IProductPtr commit(ProductIndex::Reservation reservation)
+    {
+        return take(reservedPosition(reservation));
+    }
+
+    /**
+     * @brief Makes the reserved product visible to lookups again.
+     * @return None.
+     */
+    void release(ProductIndex::Reservation reservation)
+    {
+        const auto position = reservedPosition(reservation);
+        if (position != none)
+        {
+            reserved_[position] = rowStored;
+        }
+    }
+
+    /**
+     * @brief Calls the visitor for every stored product in insertion order. The products are materialized one by one,
+     * forEachRow visits the stored columns without it.
+     * @return None.
+     */
+    void forEach(const std::function<void(const IProduct &)> &visitor) const
+    {
+        for (auto position = first_; position < rows_.size(); ++position)
+        {
+            if (reserved_[position] == rowRemoved)
+            {
+                continue;
+            }
+            const auto kept = kept_.find(rows_[position]);
+            if (kept != kept_.end())
+            {
+                visitor(*kept->second);
+                continue;
+            }
+            visitor(*build(position));
+        }
+    }
+
+    /**
+     * @brief Calls the visitor with the JSON object of every stored product in insertion order. The objects are built
+     * from the cached fields of the class descriptors, without materializing the products.
+     * @return None.
+     */
+    void forEachJson(const std::function<void(picojson::object)> &visitor) const
+    {
+        const auto &descriptors = ProductClassDescriptors::instance();
+        for (auto position = first_; position < rows_.size(); ++position)
+        {
+            if (reserved_[position] == rowRemoved)
+            {
+                continue;
+            }
+            const auto kept = kept_.find(rows_[position]);
+            const auto *descriptor = kept == kept_.end() ? descriptors.find(classes_[position]) : nullptr;
+            if (descriptor)
+            {
+                visitor(descriptor->asJson(NamePool::instance().view(names_[position]), sizes_[position]));
+                continue;
+            }
+            visitor(kept != kept_.end() ? kept->second->asJson() : build(position)->asJson());
+        }
+    }
+
+    /**
+     * @brief Calls the visitor with the class ID, name symbol, size and flags of every stored product in insertion order.
+     * @return None.
+     */
+    template <typename Visitor>
+    void forEachRow(Visitor &&visitor) const
+    {
+        for (auto position = first_; position < rows_.size(); ++position)
+        {
+            if (reserved_[position] != rowRemoved)
+            {
+                visitor(classes_[position], names_[position], sizes_[position], flags_[position]);
+            }
+        }
+    }
+
+    /**
+     * @brief Sums the sizes of all stored products, reserved ones included.
+     * @return The occupied space in OccupancyCounter micro-units.
+     */
+    OccupancyCounter::Units totalUnits() const
+    {
+        OccupancyCounter::Units units{0};
+        for (auto position = first_; position < sizes_.size(); ++position)
+        {
+            units += reserved_[position] != rowRemoved ? OccupancyCounter::toUnits(sizes_[position]) : 0;
+        }
+        return units;
+    }
+
+    std::size_t size() const
+    {
+        return rows_.size() - first_ - removed_;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Row numbers are unique across all storages, so a reservation of another storage never matches a row.
+     */
+    static inline std::atomic<std::uint64_t> nextRow{1};
+
+    /**
+     * @brief States of a row in the reserved column. Only stored rows are visible to lookups.
+     */
+    static constexpr std::uint8_t rowStored = 0;
+    static constexpr std::uint8_t rowReserved = 1;
+    static constexpr std::uint8_t rowRemoved = 2;
+
+    static Builders &buildersTable()
+    {
+        static Builders builders{};
+        return builders;
+    }
+
+    static bool hasBuilder(ProductClassId productClass)
+    {
+        auto &builders = buildersTable();
+        std::shared_lock lock{builders.mutex};
+        return productClass < builders.byClass.size() && builders.byClass[productClass];
+    }
+
+    bool matches(std::size_t position, ProductClassId productClass, NameSymbol name) const
+    {
+        return (productClass == anyProductClass || classes_[position] == productClass) &&
+               (name == anyName || names_[position] == name);
+    }
+
+    std::size_t findFirst(const RowFilter &filter) const
+    {
+        const ColumnsView columns{classes_.data(), names_.data(), sizes_.data(), flags_.data(), reserved_.data()};
+        const auto position = ScanKernels::findFirst(columns, first_, rows_.size(), filter);
+        return position < rows_.size() ? position : none;
+    }
+
+    std::size_t firstMatch(ProductClassId productClass, NameSymbol name) const
+    {
+        return findFirst(RowFilter{productClass, name});
+    }
+
+    std::size_t frontMatch(ProductClassId productClass, NameSymbol name) const
+    {
+        auto position = first_;
+        while (position < rows_.size() && reserved_[position])
+        {
+            ++position;
+        }
+        return position < rows_.size() && matches(position, productClass, name) ? position : none;
+    }
+
+    std::size_t backMatch(ProductClassId productClass, NameSymbol name) const
+    {
+        auto position = rows_.size();
+        while (position > first_ && reserved_[position - 1])
+        {
+            --position;
+        }
+        return position > first_ && matches(position - 1, productClass, name) ? position - 1 : none;
+    }
+
+    /**
+     * @brief Finds the row of a reservation. Row numbers grow in insertion order, so the row column is sorted.
+     * @return The position of the row, none if the reservation is empty, was already committed or released, or belongs
+     * to another storage.
+     */
+    std::size_t reservedPosition(ProductIndex::Reservation reservation) const
+    {
+        if (!reservation)
+        {
+            return none;
+        }
+        const auto begin = rows_.begin() + static_cast<std::ptrdiff_t>(first_);
+        const auto position =
+                static_cast<std::size_t>(std::lower_bound(begin, rows_.end(), reservation.row_) - rows_.begin());
+        return position < rows_.size() && rows_[position] == reservation.row_ && reserved_[position] == rowReserved
+                       ? position
+                       : none;
+    }
+
+    ProductIndex::Reservation mark(std::size_t position)
+    {
+        ProductIndex::Reservation reservation{};
+        if (position != none)
+        {
+            reserved_[position] = rowReserved;
+            reservation.row_ = rows_[position];
+        }
+        return reservation;
+    }
+
+    IProductPtr build(std::size_t position) const
+    {
+        auto &builders = buildersTable();
+        std::shared_lock lock{builders.mutex};
+        const auto name = std::string{NamePool::instance().view(names_[position])};
+        return builders.byClass[classes_[position]](name, sizes_[position]);
+    }
+
+    /**
+     * @brief Materializes the product and removes its row. Removing the oldest or the newest row shrinks the live range,
+     * any other row becomes a tombstone. The columns are compacted once half of them is dead.
+     * @return The removed product, nullptr if the position is none.
+     */
+    IProductPtr take(std::size_t position)
+    {
+        if (position == none)
+        {
+            return nullptr;
+        }
+        IProductPtr product{};
+        const auto kept = kept_.empty() ? kept_.end() : kept_.find(rows_[position]);
+        if (kept != kept_.end())
+        {
+            product = std::move(kept->second);
+            kept_.erase(kept);
+        }
+        else
+        {
+            product = build(position);
+        }
+
+        if (position == first_)
+        {
+            ++first_;
+            for (; first_ < rows_.size() && reserved_[first_] == rowRemoved; ++first_)
+            {
+                --removed_;
+            }
+        }
+        else if (position + 1 == rows_.size())
+        {
+            popBack();
+            while (rows_.size() > first_ && reserved_.back() == rowRemoved)
+            {
+                popBack();
+                --removed_;
+            }
+        }
+        else
+        {
+            reserved_[position] = rowRemoved;
+            ++removed_;
+        }
+        if ((first_ + removed_) * 2 >= rows_.size())
+        {
+            compact();
+        }
+        return product;
+    }
+
+    void popBack()
+    {
+        classes_.pop_back();
+        names_.pop_back();
+        sizes_.pop_back();
+        flags_.pop_back();
+        rows_.pop_back();
+        reserved_.pop_back();
+    }
+
+    /**
+     * @brief Drops the rows before the first position and the tombstones, keeping the other rows in order.
+     * @return None.
+     */
+    void compact()
+    {
+        std::size_t live = 0;
+        for (auto position = first_; position < rows_.size(); ++position)
+        {
+            if (reserved_[position] == rowRemoved)
+            {
+                continue;
+            }
+            classes_[live] = classes_[position];
+            names_[live] = names_[position];
+            sizes_[live] = sizes_[position];
+            flags_[live] = flags_[position];
+            rows_[live] = rows_[position];
+            reserved_[live] = reserved_[position];
+            ++live;
+        }
+        const auto shrink = [live](auto &column) { column.resize(live); };
+        shrink(classes_);
+        shrink(names_);
+        shrink(sizes_);
+        shrink(flags_);
+        shrink(rows_);
+        shrink(reserved_);
+        first_ = 0;
+        removed_ = 0;
+    }
+};
+
+}  // namespace warehouseInterface
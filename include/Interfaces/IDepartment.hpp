@@ -2,24 +2,209 @@
 #include <PicoJson/picojson.h>
 
 #include <Interfaces/Aliases.hpp>
+#include <Interfaces/ColumnarStorage.hpp>
 #include <Interfaces/IProduct.hpp>
+#include <Interfaces/OccupancyCounter.hpp>
+#include <Interfaces/ProductIndex.hpp>
+#include <Interfaces/ProductQuery.hpp>
 #include <MagicEnum/magic_enum.hpp>
+#include <functional>
+#include <memory>
+#include <utility>
 
 namespace warehouseInterface
 {
 class IDepartment;
 using IDepartmentPtr = std::unique_ptr<IDepartment>;
 
+/**
+ * @brief Describes which stored products are accessible in the department.
+ */
+enum class ItemAccess
+{
+    firstMatch,  // the first stored product matching the description
+    frontOnly,   // only the oldest stored product (queue)
+    backOnly     // only the newest stored product (stack)
+};
+
 class IDepartment
 {
 protected:
-    float occupancy_{};
-    float maxOccupancy_{};
+    OccupancyCounter occupancy_{};
+    OccupancyCounter maxOccupancy_{};
     float maxItemSize_{};
+    ProductIndex productIndex_{};
+    std::unique_ptr<ColumnarStorage> columnarStorage_{};
+
+    /**
+     * @brief Calls the visitor with the storage engine in use.
+     * @return The result of the visitor.
+     */
+    template <typename Visit>
+    decltype(auto) visitStorage(Visit &&visit)
+    {
+        return columnarStorage_ ? visit(*columnarStorage_) : visit(productIndex_);
+    }
+
+    template <typename Visit>
+    decltype(auto) visitStorage(Visit &&visit) const
+    {
+        return columnarStorage_ ? visit(std::as_const(*columnarStorage_)) : visit(productIndex_);
+    }
+
+    /**
+     * @brief Switches an empty department to the columnar storage engine. The store, take and reservation helpers below
+     * use the storage engine in use; departments using the columnar engine should visit their products with forEachItem.
+     * The columnar engine keeps only the columns of the products of the classes registered in the ProductFactory, so
+     * takeItem hands out a rebuilt product equal to the stored one rather than the stored object itself.
+     * @return None.
+     */
+    void useColumnarStorage()
+    {
+        if (productIndex_.empty())
+        {
+            columnarStorage_ = std::make_unique<ColumnarStorage>();
+        }
+    }
+
+    /**
+     * @brief Calls the visitor for every stored product in insertion order, whichever storage engine is in use.
+     * @return None.
+     */
+    void forEachItem(const std::function<void(const IProduct &)> &visitor) const
+    {
+        visitStorage([&visitor](const auto &storage) { storage.forEach(visitor); });
+    }
+
+    /**
+     * @brief Builds the JSON objects of the stored products in insertion order, whichever storage engine is in use. The
+     * columnar engine builds them from the cached class descriptors.
+     * @return The product JSON objects, as returned by serializedItems.
+     */
+    picojson::array itemsAsJson() const
+    {
+        picojson::array items{};
+        if (columnarStorage_)
+        {
+            columnarStorage_->forEachJson([&items](picojson::object item) { items.emplace_back(std::move(item)); });
+            return items;
+        }
+        productIndex_.forEach([&items](const IProduct &product) { items.emplace_back(product.asJson()); });
+        return items;
+    }
+
+    /**
+     * @brief Stores the product in the department index and updates the occupancy. The department conditions have to be
+     * checked by the caller.
+     * @return None.
+     */
+    void storeItem(IProductPtr product)
+    {
+        occupancy_ += product->itemSize();
+        visitStorage([&product](auto &storage) { storage.insert(std::move(product)); });
+    }
+
+    /**
+     * @brief Takes the stored product matching the query from the department index and updates the occupancy.
+     * @return Return a valid pointer if the object exists and is accessible in the department, nullptr otherwise.
+     */
+    IProductPtr takeItem(const ProductQuery &query, ItemAccess access = ItemAccess::firstMatch)
+    {
+        if (!query.satisfiable)
+        {
+            return nullptr;
+        }
+
+        auto product = visitStorage([&query, access](auto &storage) {
+            switch (access)
+            {
+                case ItemAccess::frontOnly:
+                    return storage.extractFront(query.productClass, query.name);
+                case ItemAccess::backOnly:
+                    return storage.extractBack(query.productClass, query.name);
+                case ItemAccess::firstMatch:
+                    break;
+            }
+            return storage.extract(query.productClass, query.name);
+        });
+        if (product)
+        {
+            occupancy_ -= product->itemSize();
+        }
+        return product;
+    }
+
+    /**
+     * @brief Takes the stored product matching the description from the department index and updates the occupancy.
+     * @return Return a valid pointer if the object exists and is accessible in the department, nullptr otherwise.
+     */
+    IProductPtr takeItem(const ProductDescriptionJson &description, ItemAccess access = ItemAccess::firstMatch)
+    {
+        return takeItem(ProductQuery::compile(description), access);
+    }
 
 public:
     virtual ~IDepartment() = default;
 
+    /**
+     * @brief Get the occupancy of the department in OccupancyCounter micro-units.
+     * @return The occupied space.
+     */
+    OccupancyCounter::Units occupancyUnits() const
+    {
+        return occupancy_.units();
+    }
+
+    /**
+     * @brief Get the maximal occupancy of the department in OccupancyCounter micro-units.
+     * @return The department space.
+     */
+    OccupancyCounter::Units maxOccupancyUnits() const
+    {
+        return maxOccupancy_.units();
+    }
+
+    /**
+     * @brief Checks in micro-units if the department would have room for an item of the size at the occupancy. The
+     * warehouse applies it to tentative occupancies on top of canAdd, so departments should accept every product it admits.
+     * @return true if the item is not bigger than the maximal item size and fits in the free space, false otherwise.
+     */
+    bool hasRoomFor(float size, OccupancyCounter::Units occupancy) const
+    {
+        return size <= maxItemSize_ && occupancy + OccupancyCounter::toUnits(size) <= maxOccupancy_.units();
+    }
+
+    /**
+     * @brief Checks in micro-units if the department has room for the product. The product flags are checked by canAdd.
+     * @return true if the product is not bigger than the maximal item size and fits in the free space, false otherwise.
+     */
+    bool hasRoomFor(const IProduct &product) const
+    {
+        return hasRoomFor(product.itemSize(), occupancy_.units());
+    }
+
+    /**
+     * @brief Checks if addItem would store the product, without handing the product over. The warehouse only hands products
+     * to departments confirming them here, so departments with other conditions than the default ones should override it
+     * with the checks of their addItem.
+     * @return true if the department supports one of the product flags and has room for the product, false otherwise.
+     */
+    virtual bool canAdd(const IProduct &product) const
+    {
+        const auto flags = static_cast<unsigned>(product.itemFlags()) & static_cast<unsigned>(getSupportedFlags());
+        return flags != 0 && hasRoomFor(product);
+    }
+
+    /**
+     * @brief Takes back the newest stored product with the key, which undoes addItem as long as the product was not handed
+     * out and no product with the same key was stored after it. Only products stored with storeItem can be taken back.
+     * @return The product, nullptr if no stored product has the key.
+     */
+    IProductPtr takeBackItem(const ProductKey &key)
+    {
+        return takeItem(ProductQuery{key.productClass, key.name}, ItemAccess::backOnly);
+    }
+
     /**
      * @brief Adds new elements to department space if possible.
      * @return Return true if the item size meets department conditions and added item pointer is not nullptr, false otherwise.
@@ -34,6 +219,76 @@ public:
      */
     virtual IProductPtr getItem(const ProductDescriptionJson &) = 0;
 
+    /**
+     * @brief Gets new elements from the department if possible, using an already compiled description. Departments storing
+     * products in the department index should override it with takeItem(query), and make the string overload a thin
+     * wrapper compiling the description. The default implementation serializes the query for the string overload.
+     * @return Return a valid pointer if the object exists and is accessible in the department, nullptr otherwise.
+     */
+    virtual IProductPtr getItem(const ProductQuery &query)
+    {
+        return query.satisfiable ? getItem(query.serialize()) : nullptr;
+    }
+
+    /**
+     * @brief Describes which stored products getItem hands out. Departments calling takeItem with another access than
+     * firstMatch should return it here, so reservations follow the same discipline.
+     * @return The item access of the department.
+     */
+    virtual ItemAccess itemAccess() const
+    {
+        return ItemAccess::firstMatch;
+    }
+
+    /**
+     * @brief Reserves the product getItem would hand out for the query, without taking it out of the department. The
+     * reserved product keeps its space and is hidden from getItem and from other reservations until the reservation is
+     * committed or released. Only products stored in the department index can be reserved.
+     * @return A valid reservation if the object exists and is accessible in the department, an empty one otherwise.
+     */
+    ProductIndex::Reservation reserveItem(const ProductQuery &query)
+    {
+        if (!query.satisfiable)
+        {
+            return {};
+        }
+        return visitStorage([&query, access = itemAccess()](auto &storage) {
+            switch (access)
+            {
+                case ItemAccess::frontOnly:
+                    return storage.reserveFront(query.productClass, query.name);
+                case ItemAccess::backOnly:
+                    return storage.reserveBack(query.productClass, query.name);
+                case ItemAccess::firstMatch:
+                    break;
+            }
+            return storage.reserve(query.productClass, query.name);
+        });
+    }
+
+    /**
+     * @brief Takes the reserved product out of the department and updates the occupancy.
+     * @return The reserved product, nullptr if the reservation is empty.
+     */
+    IProductPtr commitReservation(ProductIndex::Reservation reservation)
+    {
+        auto product = visitStorage([reservation](auto &storage) { return storage.commit(reservation); });
+        if (product)
+        {
+            occupancy_ -= product->itemSize();
+        }
+        return product;
+    }
+
+    /**
+     * @brief Gives the reserved product back to getItem, at its old place.
+     * @return None.
+     */
+    void releaseReservation(ProductIndex::Reservation reservation)
+    {
+        visitStorage([reservation](auto &storage) { storage.release(reservation); });
+    }
+
     /**
      * @brief Get the actual occupancy of the department.
      * @return A float representing the occupancy of the department.
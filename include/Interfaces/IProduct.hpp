@@ -1,15 +1,49 @@
 #pragma once
 #include <Interfaces/Aliases.hpp>
+#include <Interfaces/NamePool.hpp>
+#include <Interfaces/ProductArena.hpp>
+#include <Interfaces/ProductClassDescriptor.hpp>
+#include <Interfaces/ProductClassTable.hpp>
 #include <Interfaces/ProductFlags.hpp>
 #include <PicoJson/picojson.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace warehouseInterface
 {
 class IProduct;
-using IProductPtr = std::unique_ptr<IProduct>;
+
+/**
+ * @brief Deleter of products. Products created by the ProductFactory live in a ProductArena bucket and are given back
+ * to it, products created with new (e.g. std::make_unique) are deleted.
+ */
+class ProductDeleter
+{
+    SlabBucket *bucket_{};
+
+public:
+    ProductDeleter() = default;
+
+    explicit ProductDeleter(SlabBucket &bucket) : bucket_{&bucket}
+    {
+    }
+
+    template <typename Product>
+    ProductDeleter(std::default_delete<Product>)
+    {
+    }
+
+    bool pooled() const
+    {
+        return bucket_ != nullptr;
+    }
+
+    void operator()(IProduct *product) const;
+};
+
+using IProductPtr = std::unique_ptr<IProduct, ProductDeleter>;
 
 /**
  * @brief The warehouse order structure.
@@ -24,9 +58,71 @@ struct Order
 
 class IProduct
 {
+    mutable const ProductClassDescriptor *descriptor_{};
+    mutable NameSymbol nameSymbol_{anyName};
+
+protected:
+    /**
+     * @brief Assigns the class descriptor and the name symbol, for factories creating products of a described class.
+     * @return None.
+     */
+    void assignIdentity(const ProductClassDescriptor &descriptor, NameSymbol nameSymbol)
+    {
+        descriptor_ = &descriptor;
+        nameSymbol_ = nameSymbol;
+    }
+
 public:
     virtual ~IProduct() = default;
 
+    /**
+     * @brief Get the descriptor shared by all products of the class. The descriptor is assigned by the ProductFactory; for
+     * products created elsewhere it is resolved once from the product JSON.
+     * @return The class descriptor, valid for the lifetime of the process.
+     */
+    const ProductClassDescriptor &descriptor() const
+    {
+        if (!descriptor_)
+        {
+            auto json = asJson();
+            const auto classId = ProductClassTable::instance().intern(json["class"].to_str());
+            descriptor_ = &ProductClassDescriptors::instance().describe(classId, itemFlags(), std::move(json));
+        }
+        return *descriptor_;
+    }
+
+    /**
+     * @brief Get the interned class ID of the product.
+     * @return A ProductClassId representing the product class.
+     */
+    ProductClassId classId() const
+    {
+        return descriptor().classId;
+    }
+
+    /**
+     * @brief Get the symbol of the product name in the NamePool. The symbol is assigned by the ProductFactory; for products
+     * created elsewhere the name is interned once.
+     * @return A NameSymbol representing the product name.
+     */
+    NameSymbol nameSymbol() const
+    {
+        if (nameSymbol_ == anyName)
+        {
+            nameSymbol_ = NamePool::instance().intern(name());
+        }
+        return nameSymbol_;
+    }
+
+    /**
+     * @brief Get the name of the product without copying it.
+     * @return A view of the interned product name, valid for the lifetime of the process.
+     */
+    std::string_view nameView() const
+    {
+        return NamePool::instance().view(nameSymbol());
+    }
+
     /**
      * @brief Get the name of the product.
      * @return A string representing the name of the product.
@@ -57,4 +153,16 @@ public:
      */
     virtual ProductDescriptionJson serialize() const = 0;
 };
+
+inline void ProductDeleter::operator()(IProduct *product) const
+{
+    if (!bucket_)
+    {
+        delete product;
+        return;
+    }
+    auto *block = dynamic_cast<void *>(product);
+    product->~IProduct();
+    bucket_->deallocate(block);
+}
 }  // namespace warehouseInterface
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <Interfaces/IDepartment.hpp>
 #include <Interfaces/IProduct.hpp>
+#include <span>
+#include <vector>
 
 namespace warehouseInterface
 {
@@ -34,6 +36,21 @@ public:
      */
     virtual Order newOrder(const OrderJson &) = 0;
 
+    /**
+     * @brief Fulfils a wave of orders. The result is the same as calling newOrder for every order in turn.
+     * @return Vector of orders, in the same order as the requested ones.
+     */
+    virtual std::vector<Order> newOrders(std::span<const OrderJson> orders)
+    {
+        std::vector<Order> result{};
+        result.reserve(orders.size());
+        for (const auto &order : orders)
+        {
+            result.push_back(newOrder(order));
+        }
+        return result;
+    }
+
     /**
      * @brief Gets the warehouse occupancy report.
      * @return Warehouse occupancy as serialized JSON object.
@@ -0,0 +1,111 @@
+#pragma once
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Process-wide table of interned strings. Every string gets a dense integer ID the first time it is interned and is
+ * stored only once, so the rest of the warehouse compares and indexes such strings by ID. Interned strings are never
+ * removed, hence views returned by the table stay valid for the lifetime of the process.
+ * @param Id The unsigned integer type of the IDs. Its maximal value is reserved and means "any".
+ * @param Tag The tag type making a separate table for every kind of interned strings.
+ */
+template <typename Id, typename Tag>
+class InternTable
+{
+    mutable std::shared_mutex mutex_{};
+    std::unordered_map<std::string_view, Id> ids_{};
+    std::deque<std::string> strings_{};
+
+    InternTable() = default;
+
+public:
+    /**
+     * @brief Reserved ID matching any string.
+     */
+    static constexpr Id any = std::numeric_limits<Id>::max();
+
+    InternTable(const InternTable &) = delete;
+    InternTable &operator=(const InternTable &) = delete;
+
+    static InternTable &instance()
+    {
+        static InternTable table{};
+        return table;
+    }
+
+    /**
+     * @brief Gets the ID of the string, assigning the next free ID if the string is not known yet.
+     * @return The string ID. Throws std::length_error if all IDs are assigned.
+     */
+    Id intern(std::string_view string)
+    {
+        {
+            std::shared_lock lock{mutex_};
+            const auto id = ids_.find(string);
+            if (id != ids_.end())
+            {
+                return id->second;
+            }
+        }
+
+        std::unique_lock lock{mutex_};
+        const auto id = ids_.find(string);
+        if (id != ids_.end())
+        {
+            return id->second;
+        }
+        if (strings_.size() >= any)
+        {
+            throw std::length_error("Intern table is full.");
+        }
+        const auto newId = static_cast<Id>(strings_.size());
+        ids_.emplace(strings_.emplace_back(string), newId);
+        return newId;
+    }
+
+    /**
+     * @brief Gets the ID of an already interned string.
+     * @return The string ID, or any if the string is unknown.
+     */
+    Id find(std::string_view string) const
+    {
+        std::shared_lock lock{mutex_};
+        const auto id = ids_.find(string);
+        return id != ids_.end() ? id->second : any;
+    }
+
+    /**
+     * @brief Gets the interned string of the ID without copying it.
+     * @return A view of the interned string, or an empty view if the ID is unknown.
+     */
+    std::string_view view(Id id) const
+    {
+        std::shared_lock lock{mutex_};
+        return id < strings_.size() ? std::string_view{strings_[id]} : std::string_view{};
+    }
+
+    /**
+     * @brief Gets the interned string of the ID.
+     * @return The string, or an empty string if the ID is unknown.
+     */
+    std::string name(Id id) const
+    {
+        return std::string{view(id)};
+    }
+
+    std::size_t size() const
+    {
+        std::shared_lock lock{mutex_};
+        return strings_.size();
+    }
+};
+
+}  // namespace warehouseInterface
@@ -0,0 +1,25 @@
+#pragma once
+#include <Interfaces/InternTable.hpp>
+#include <cstdint>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Symbol ID of an interned product name.
+ */
+using NameSymbol = std::uint32_t;
+
+/**
+ * @brief Process-wide pool of product names. Deliveries repeat the same names over and over, so every name is stored once
+ * and products reference it by symbol; comparing names is a single integer compare. The pool is not owned by a factory
+ * or a warehouse: products outlive the factory creating them and move between warehouses, and symbols are only
+ * comparable within one pool. Names are never freed, so the pool grows with the number of distinct names.
+ */
+using NamePool = InternTable<NameSymbol, struct NamePoolTag>;
+
+/**
+ * @brief Reserved name symbol matching any product name.
+ */
+inline constexpr NameSymbol anyName = NamePool::any;
+
+}  // namespace warehouseInterface
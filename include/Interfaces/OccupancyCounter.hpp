@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Department space kept as an atomic integer number of micro-units (millionths of a size unit). A product size is
+ * rounded to micro-units once, so storing and taking the same products always nets back to the same value, and the
+ * counter is updated with fetch-add and read without locks from any thread. It converts to float only at the API and
+ * JSON boundary. Values are saturated at 9.2e12 size units.
+ */
+class OccupancyCounter
+{
+public:
+    using Units = std::int64_t;
+
+    static constexpr double unitsPerSize = 1e6;
+
+    /**
+     * @brief Converts a size to micro-units, rounding to the nearest one.
+     * @return The number of micro-units.
+     */
+    static Units toUnits(float size)
+    {
+        constexpr double limit = 9.2e18;
+        const auto units = std::round(static_cast<double>(size) * unitsPerSize);
+        return std::isnan(units) ? 0 : static_cast<Units>(std::clamp(units, -limit, limit));
+    }
+
+    static float toSize(Units units)
+    {
+        return static_cast<float>(static_cast<double>(units) / unitsPerSize);
+    }
+
+    OccupancyCounter() = default;
+
+    OccupancyCounter(float size) : units_{toUnits(size)}
+    {
+    }
+
+    OccupancyCounter(const OccupancyCounter &) = delete;
+
+    OccupancyCounter &operator=(float size)
+    {
+        units_.store(toUnits(size), std::memory_order_relaxed);
+        return *this;
+    }
+
+    OccupancyCounter &operator+=(float size)
+    {
+        units_.fetch_add(toUnits(size), std::memory_order_relaxed);
+        return *this;
+    }
+
+    OccupancyCounter &operator-=(float size)
+    {
+        units_.fetch_sub(toUnits(size), std::memory_order_relaxed);
+        return *this;
+    }
+
+    Units units() const
+    {
+        return units_.load(std::memory_order_relaxed);
+    }
+
+    operator float() const
+    {
+        return toSize(units());
+    }
+
+private:
+    std::atomic<Units> units_{0};
+};
+
+}  // namespace warehouseInterface
@@ -0,0 +1,211 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Slab allocator of equally sized blocks. Blocks are cut from 64 KiB slabs and freed blocks are kept in an
+ * intrusive free list for reuse, so allocating a product costs a pointer pop instead of a heap allocation. Slabs are
+ * never given back to the system, the freed space is only reused by the bucket.
+ */
+class SlabBucket
+{
+    friend class BulkRelease;
+
+    struct FreeBlock
+    {
+        FreeBlock *next{};
+    };
+
+    static constexpr std::size_t slabSize = 64 * 1024;
+
+    const std::size_t blockSize_;
+    std::mutex mutex_{};
+    FreeBlock *free_{};
+    std::vector<std::unique_ptr<std::byte[]>> slabs_{};
+    std::byte *next_{};
+    std::byte *end_{};
+
+public:
+    /**
+     * @brief Alignment of every block, enough for any product class.
+     */
+    static constexpr std::size_t blockAlignment = alignof(std::max_align_t);
+
+    explicit SlabBucket(std::size_t size) : blockSize_{blockSizeOf(size)}
+    {
+    }
+
+    /**
+     * @brief Rounds the object size up to the block size of its bucket.
+     * @return The block size.
+     */
+    static constexpr std::size_t blockSizeOf(std::size_t size)
+    {
+        return (std::max(size, sizeof(FreeBlock)) + blockAlignment - 1) / blockAlignment * blockAlignment;
+    }
+
+    SlabBucket(const SlabBucket &) = delete;
+    SlabBucket &operator=(const SlabBucket &) = delete;
+
+    std::size_t blockSize() const
+    {
+        return blockSize_;
+    }
+
+    /**
+     * @brief Takes a free block, cutting a new slab if there is none.
+     * @return Uninitialized memory of blockSize bytes.
+     */
+    void *allocate()
+    {
+        std::lock_guard lock{mutex_};
+        if (free_)
+        {
+            return std::exchange(free_, free_->next);
+        }
+        if (next_ == end_)
+        {
+            const auto blocks = std::max<std::size_t>(slabSize / blockSize_, 1);
+            slabs_.push_back(std::make_unique_for_overwrite<std::byte[]>(blocks * blockSize_));
+            next_ = slabs_.back().get();
+            end_ = next_ + blocks * blockSize_;
+        }
+        return std::exchange(next_, next_ + blockSize_);
+    }
+
+    /**
+     * @brief Gives the block back to the bucket, or to the bulk release of the calling thread if one is active.
+     * @return None.
+     */
+    void deallocate(void *block);
+
+private:
+    void deallocate(FreeBlock *first, FreeBlock *last)
+    {
+        std::lock_guard lock{mutex_};
+        last->next = free_;
+        free_ = first;
+    }
+};
+
+/**
+ * @brief Process-wide arena of product memory with one slab bucket per block size. Every product class registered in
+ * the ProductFactory gets the bucket of its size. The arena is never destroyed, so products may outlive any factory.
+ */
+class ProductArena
+{
+    std::mutex mutex_{};
+    std::deque<SlabBucket> buckets_{};
+
+    ProductArena() = default;
+
+public:
+    ProductArena(const ProductArena &) = delete;
+    ProductArena &operator=(const ProductArena &) = delete;
+
+    static ProductArena &instance()
+    {
+        static auto *arena = new ProductArena{};
+        return *arena;
+    }
+
+    /**
+     * @brief Gets the bucket of blocks fitting objects of the size, creating it on first use.
+     * @return The bucket, valid for the lifetime of the process.
+     */
+    SlabBucket &bucket(std::size_t size)
+    {
+        std::lock_guard lock{mutex_};
+        const auto blockSize = SlabBucket::blockSizeOf(size);
+        const auto found = std::find_if(buckets_.begin(), buckets_.end(),
+                                        [blockSize](const SlabBucket &bucket) { return bucket.blockSize() == blockSize; });
+        return found != buckets_.end() ? *found : buckets_.emplace_back(size);
+    }
+};
+
+/**
+ * @brief Scope in which the blocks freed by the current thread are collected per bucket and handed back to their
+ * buckets with one lock each when the scope ends, instead of one lock per product. Used when a whole department or
+ * warehouse is destroyed. Nested scopes join the outermost one.
+ */
+class BulkRelease
+{
+    struct Batch
+    {
+        SlabBucket *bucket{};
+        SlabBucket::FreeBlock *first{};
+        SlabBucket::FreeBlock *last{};
+    };
+
+    static inline thread_local BulkRelease *active_{};
+
+    std::vector<Batch> batches_{};
+    bool outermost_{active_ == nullptr};
+
+public:
+    BulkRelease()
+    {
+        if (outermost_)
+        {
+            active_ = this;
+        }
+    }
+
+    BulkRelease(const BulkRelease &) = delete;
+    BulkRelease &operator=(const BulkRelease &) = delete;
+
+    ~BulkRelease()
+    {
+        if (!outermost_)
+        {
+            return;
+        }
+        active_ = nullptr;
+        for (const auto &batch : batches_)
+        {
+            batch.bucket->deallocate(batch.first, batch.last);
+        }
+    }
+
+    /**
+     * @brief Collects the block if a bulk release is active on the calling thread.
+     * @return true if the block was collected, false otherwise.
+     */
+    static bool collect(SlabBucket &bucket, void *block)
+    {
+        if (!active_)
+        {
+            return false;
+        }
+        auto &batches = active_->batches_;
+        auto batch = std::find_if(batches.begin(), batches.end(), [&bucket](const Batch &b) { return b.bucket == &bucket; });
+        if (batch == batches.end())
+        {
+            batch = batches.insert(batches.end(), Batch{&bucket, nullptr, nullptr});
+        }
+        auto *freeBlock = ::new (block) SlabBucket::FreeBlock{batch->first};
+        batch->first = freeBlock;
+        batch->last = batch->last ? batch->last : freeBlock;
+        return true;
+    }
+};
+
+inline void SlabBucket::deallocate(void *block)
+{
+    if (BulkRelease::collect(*this, block))
+    {
+        return;
+    }
+    std::lock_guard lock{mutex_};
+    free_ = ::new (block) FreeBlock{free_};
+}
+
+}  // namespace warehouseInterface
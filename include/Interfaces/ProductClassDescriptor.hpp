@@ -0,0 +1,129 @@
+#pragma once
+#include <Interfaces/Aliases.hpp>
+#include <Interfaces/ProductClassTable.hpp>
+#include <Interfaces/ProductFlags.hpp>
+#include <PicoJson/picojson.h>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Metadata shared by all products of a class (flyweight). Products point to the descriptor of their class, so
+ * the class name, flags and their JSON are stored once per class instead of being rebuilt for every product.
+ * @param classId Interned ID of the class.
+ * @param className Name of the class.
+ * @param flags Flags of the products of the class.
+ * @param fields Fields of the product JSON which are the same for all products of the class ("class", "flags").
+ * @param fieldsJson The fields rendered as the beginning of a serialized JSON object, without the closing brace.
+ */
+struct ProductClassDescriptor
+{
+    ProductClassId classId{anyProductClass};
+    std::string className{};
+    ProductLabelFlags flags{};
+    picojson::object fields{};
+    std::string fieldsJson{};
+
+    /**
+     * @brief Builds the JSON of a product of the class from the cached fields.
+     * @return The same JSON object as the product asJson.
+     */
+    picojson::object asJson(std::string_view name, float size) const
+    {
+        auto json = fields;
+        json["name"] = picojson::value(std::string{name});
+        json["size"] = picojson::value(static_cast<double>(size));
+        return json;
+    }
+
+    /**
+     * @brief Serializes a product of the class, appending the name and the size to the pre-rendered fields. JSON object
+     * keys are serialized in alphabetical order, so the fields are only spliced if they all sort before "name".
+     * @return The same JSON string as the product serialize.
+     */
+    ProductDescriptionJson serialize(std::string_view name, float size) const
+    {
+        if (!fields.empty() && fields.rbegin()->first >= "name")
+        {
+            return picojson::value(asJson(name, size)).serialize();
+        }
+        auto json = fieldsJson;
+        json += fields.empty() ? "\"name\":" : ",\"name\":";
+        json += picojson::value(std::string{name}).serialize();
+        json += ",\"size\":";
+        json += picojson::value(static_cast<double>(size)).serialize();
+        json += '}';
+        return json;
+    }
+};
+
+/**
+ * @brief Process-wide table of product class descriptors, indexed by class ID. Descriptors are never removed, hence
+ * references returned by the table stay valid for the lifetime of the process.
+ */
+class ProductClassDescriptors
+{
+    mutable std::shared_mutex mutex_{};
+    std::deque<ProductClassDescriptor> descriptors_{};
+    std::vector<const ProductClassDescriptor *> byClass_{};
+
+    ProductClassDescriptors() = default;
+
+public:
+    ProductClassDescriptors(const ProductClassDescriptors &) = delete;
+    ProductClassDescriptors &operator=(const ProductClassDescriptors &) = delete;
+
+    static ProductClassDescriptors &instance()
+    {
+        static ProductClassDescriptors descriptors{};
+        return descriptors;
+    }
+
+    /**
+     * @brief Gets the descriptor of the class, creating it from the JSON of a product of the class on first use. The
+     * first product described fixes the flags and the fields of the class.
+     * @return The class descriptor.
+     */
+    const ProductClassDescriptor &describe(ProductClassId classId, ProductLabelFlags flags, picojson::object json)
+    {
+        if (const auto *descriptor = find(classId))
+        {
+            return *descriptor;
+        }
+
+        std::unique_lock lock{mutex_};
+        if (classId < byClass_.size() && byClass_[classId])
+        {
+            return *byClass_[classId];
+        }
+        json.erase("name");
+        json.erase("size");
+        auto fieldsJson = picojson::value(json).serialize();
+        fieldsJson.pop_back();
+        auto &descriptor = descriptors_.emplace_back(ProductClassDescriptor{
+                classId, ProductClassTable::instance().name(classId), flags, std::move(json), std::move(fieldsJson)});
+        if (classId >= byClass_.size())
+        {
+            byClass_.resize(classId + 1);
+        }
+        byClass_[classId] = &descriptor;
+        return descriptor;
+    }
+
+    /**
+     * @brief Gets the descriptor of an already described class.
+     * @return The class descriptor, nullptr if the class was not described yet.
+     */
+    const ProductClassDescriptor *find(ProductClassId classId) const
+    {
+        std::shared_lock lock{mutex_};
+        return classId < byClass_.size() ? byClass_[classId] : nullptr;
+    }
+};
+
+}  // namespace warehouseInterface
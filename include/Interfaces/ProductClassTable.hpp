@@ -0,0 +1,23 @@
+#pragma once
+#include <Interfaces/InternTable.hpp>
+#include <cstdint>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Compact integer ID of a product class.
+ */
+using ProductClassId = std::uint16_t;
+
+/**
+ * @brief Process-wide table of product class names. Products, departments and the warehouse compare and index classes
+ * by ID, and class name strings only appear at the JSON boundary.
+ */
+using ProductClassTable = InternTable<ProductClassId, struct ProductClassTag>;
+
+/**
+ * @brief Reserved class ID matching any product class.
+ */
+inline constexpr ProductClassId anyProductClass = ProductClassTable::any;
+
+}  // namespace warehouseInterface
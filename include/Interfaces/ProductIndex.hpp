@@ -0,0 +1,383 @@
+#pragma once
+#include <Interfaces/IProduct.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace warehouseInterface
+{
+/**
+ * @brief The key under which a stored product is indexed.
+ * @param productClass Interned product class ID.
+ * @param name Interned product name symbol.
+ */
+struct ProductKey
+{
+    ProductClassId productClass{anyProductClass};
+    NameSymbol name{anyName};
+
+    bool operator==(const ProductKey &) const = default;
+};
+
+struct ProductKeyHash
+{
+    std::size_t operator()(const ProductKey &key) const noexcept
+    {
+        return std::hash<std::uint64_t>{}(static_cast<std::uint64_t>(key.productClass) << 32 | key.name);
+    }
+};
+
+/**
+ * @brief Department product storage with secondary FIFO indexes. Products are kept in insertion order and every stored
+ * product is linked into three insertion-ordered chains: one per (class, name) key, one per class and one per name. The
+ * chains are intrusive and cross-linked through the stored entry, so the first product matching a full or a partial
+ * description is found and unlinked from every index in constant time, no matter how big the department gets.
+ * A product can be reserved: it stays stored and linked, but a flag on its entry hides it from every lookup until the
+ * reservation is committed (the product is removed) or released (the product is visible again at its old place).
+ */
+class ProductIndex
+{
+    enum Chain
+    {
+        byKey,
+        byClass,
+        byName,
+        chainsCount
+    };
+
+    struct Entry;
+
+    struct Bucket
+    {
+        Entry *head{};
+        Entry *tail{};
+    };
+
+    struct Link
+    {
+        Bucket *bucket{};
+        Entry *prev{};
+        Entry *next{};
+    };
+
+    struct Entry
+    {
+        ProductKey key;
+        IProductPtr product;
+        std::array<Link, chainsCount> links{};
+        std::list<Entry>::iterator position{};
+        bool reserved{false};
+    };
+
+    using Storage = std::list<Entry>;
+
+    Storage items_{};
+    std::unordered_map<ProductKey, Bucket, ProductKeyHash> byKey_{};
+    std::deque<Bucket> byClass_{};
+    std::unordered_map<NameSymbol, Bucket> byName_{};
+    std::unordered_map<std::uint64_t, Entry *> reservations_{};
+
+    /**
+     * @brief Reservation numbers are unique across all indexes, so a reservation of another index is never found.
+     */
+    static inline std::atomic<std::uint64_t> nextReservation{1};
+
+public:
+    /**
+     * @brief Handle of a reserved product. The ProductIndex refers to the reservation by its number, the ColumnarStorage
+     * by the reserved row. The storages look the handle up, so committing or releasing a handle which was already
+     * committed or released, or which belongs to another storage, does nothing.
+     */
+    class Reservation
+    {
+        friend class ProductIndex;
+        friend class ColumnarStorage;
+        std::uint64_t id_{};
+        std::uint64_t row_{};
+
+    public:
+        Reservation() = default;
+
+        explicit operator bool() const
+        {
+            return id_ != 0 || row_ != 0;
+        }
+    };
+
+    ProductIndex() = default;
+    ProductIndex(const ProductIndex &) = delete;
+    ProductIndex &operator=(const ProductIndex &) = delete;
+
+    /**
+     * @brief Builds the index key of the product.
+     * @return A key with the product class ID and the product name symbol.
+     */
+    static ProductKey keyOf(const IProduct &product)
+    {
+        return {product.classId(), product.nameSymbol()};
+    }
+
+    /**
+     * @brief Stores the product at the end of the department and of all its index chains.
+     * @return None.
+     */
+    void insert(IProductPtr product)
+    {
+        auto key = keyOf(*product);
+        auto &entry = items_.emplace_back(Entry{std::move(key), std::move(product)});
+        entry.position = std::prev(items_.end());
+
+        link(entry, byKey, byKey_[entry.key]);
+        if (entry.key.productClass >= byClass_.size())
+        {
+            byClass_.resize(entry.key.productClass + 1);
+        }
+        link(entry, byClass, byClass_[entry.key.productClass]);
+        link(entry, byName, byName_[entry.key.name]);
+    }
+
+    /**
+     * @brief Removes the first stored product matching the class and the name. The anyProductClass class or the anyName
+     * name is not considered in the matching.
+     * @return A valid pointer if a matching product is stored, nullptr otherwise.
+     */
+    IProductPtr extract(ProductClassId productClass, NameSymbol name)
+    {
+        auto *entry = firstMatch(productClass, name);
+        return entry ? take(*entry) : nullptr;
+    }
+
+    /**
+     * @brief Removes the oldest stored product if it matches the class and the name (queue access).
+     * @return A valid pointer if the oldest product matches, nullptr otherwise.
+     */
+    IProductPtr extractFront(ProductClassId productClass, NameSymbol name)
+    {
+        auto *entry = frontMatch(productClass, name);
+        return entry ? take(*entry) : nullptr;
+    }
+
+    /**
+     * @brief Removes the newest stored product if it matches the class and the name (stack access).
+     * @return A valid pointer if the newest product matches, nullptr otherwise.
+     */
+    IProductPtr extractBack(ProductClassId productClass, NameSymbol name)
+    {
+        auto *entry = backMatch(productClass, name);
+        return entry ? take(*entry) : nullptr;
+    }
+
+    /**
+     * @brief Reserves the product extract would remove.
+     * @return A valid reservation if a matching product is stored, an empty one otherwise.
+     */
+    Reservation reserve(ProductClassId productClass, NameSymbol name)
+    {
+        return mark(firstMatch(productClass, name));
+    }
+
+    /**
+     * @brief Reserves the product extractFront would remove.
+     * @return A valid reservation if the oldest product matches, an empty one otherwise.
+     */
+    Reservation reserveFront(ProductClassId productClass, NameSymbol name)
+    {
+        return mark(frontMatch(productClass, name));
+    }
+
+    /**
+     * @brief Reserves the product extractBack would remove.
+     * @return A valid reservation if the newest product matches, an empty one otherwise.
+     */
+    Reservation reserveBack(ProductClassId productClass, NameSymbol name)
+    {
+        return mark(backMatch(productClass, name));
+    }
+
+    /**
+     * @brief Removes the reserved product.
+     * @return The removed product, nullptr if the reservation is empty, ended or belongs to another storage.
+     */
+    IProductPtr commit(Reservation reservation)
+    {
+        auto *entry = endReservation(reservation);
+        return entry ? take(*entry) : nullptr;
+    }
+
+    /**
+     * @brief Makes the reserved product visible to lookups again.
+     * @return None.
+     */
+    void release(Reservation reservation)
+    {
+        if (auto *entry = endReservation(reservation))
+        {
+            entry->reserved = false;
+        }
+    }
+
+    /**
+     * @brief Calls the visitor for every stored product in insertion order.
+     * @return None.
+     */
+    void forEach(const std::function<void(const IProduct &)> &visitor) const
+    {
+        for (const auto &entry : items_)
+        {
+            visitor(*entry.product);
+        }
+    }
+
+    std::size_t size() const
+    {
+        return items_.size();
+    }
+
+    bool empty() const
+    {
+        return items_.empty();
+    }
+
+private:
+    static bool matches(const ProductKey &key, ProductClassId productClass, NameSymbol name)
+    {
+        return (productClass == anyProductClass || key.productClass == productClass) && (name == anyName || key.name == name);
+    }
+
+    template <typename Map, typename Key>
+    static Entry *headOf(Map &map, const Key &key)
+    {
+        const auto bucket = map.find(key);
+        return bucket != map.end() ? bucket->second.head : nullptr;
+    }
+
+    /**
+     * @brief Skips the reserved entries of the chain.
+     * @return The first unreserved entry from the given one on, nullptr if there is none.
+     */
+    static Entry *firstUnreserved(Entry *entry, Chain chain)
+    {
+        while (entry && entry->reserved)
+        {
+            entry = entry->links[chain].next;
+        }
+        return entry;
+    }
+
+    Entry *firstMatch(ProductClassId productClass, NameSymbol name)
+    {
+        if (productClass != anyProductClass && name != anyName)
+        {
+            return firstUnreserved(headOf(byKey_, ProductKey{productClass, name}), byKey);
+        }
+        if (productClass != anyProductClass)
+        {
+            return productClass < byClass_.size() ? firstUnreserved(byClass_[productClass].head, byClass) : nullptr;
+        }
+        if (name != anyName)
+        {
+            return firstUnreserved(headOf(byName_, name), byName);
+        }
+        const auto entry = std::find_if(items_.begin(), items_.end(), [](const Entry &item) { return !item.reserved; });
+        return entry != items_.end() ? &*entry : nullptr;
+    }
+
+    Entry *frontMatch(ProductClassId productClass, NameSymbol name)
+    {
+        const auto entry = std::find_if(items_.begin(), items_.end(), [](const Entry &item) { return !item.reserved; });
+        return entry != items_.end() && matches(entry->key, productClass, name) ? &*entry : nullptr;
+    }
+
+    Entry *backMatch(ProductClassId productClass, NameSymbol name)
+    {
+        const auto entry = std::find_if(items_.rbegin(), items_.rend(), [](const Entry &item) { return !item.reserved; });
+        return entry != items_.rend() && matches(entry->key, productClass, name) ? &*entry : nullptr;
+    }
+
+    Reservation mark(Entry *entry)
+    {
+        Reservation reservation{};
+        if (entry)
+        {
+            entry->reserved = true;
+            reservation.id_ = nextReservation.fetch_add(1, std::memory_order_relaxed);
+            reservations_.emplace(reservation.id_, entry);
+        }
+        return reservation;
+    }
+
+    /**
+     * @brief Ends the reservation, keeping its entry reserved.
+     * @return The reserved entry, nullptr if the reservation is empty, was already committed or released, or belongs to
+     * another storage.
+     */
+    Entry *endReservation(Reservation reservation)
+    {
+        const auto reserved = reservations_.find(reservation.id_);
+        if (reserved == reservations_.end())
+        {
+            return nullptr;
+        }
+        auto *entry = reserved->second;
+        reservations_.erase(reserved);
+        return entry;
+    }
+
+    static void link(Entry &entry, Chain chain, Bucket &bucket)
+    {
+        auto &entryLink = entry.links[chain];
+        entryLink.bucket = &bucket;
+        entryLink.prev = bucket.tail;
+        if (bucket.tail)
+        {
+            bucket.tail->links[chain].next = &entry;
+        }
+        else
+        {
+            bucket.head = &entry;
+        }
+        bucket.tail = &entry;
+    }
+
+    /**
+     * @brief Unlinks the entry from the chain in constant time.
+     * @return true if the chain bucket became empty, false otherwise.
+     */
+    static bool unlink(Entry &entry, Chain chain)
+    {
+        auto &entryLink = entry.links[chain];
+        auto &bucket = *entryLink.bucket;
+        (entryLink.prev ? entryLink.prev->links[chain].next : bucket.head) = entryLink.next;
+        (entryLink.next ? entryLink.next->links[chain].prev : bucket.tail) = entryLink.prev;
+        return bucket.head == nullptr;
+    }
+
+    /**
+     * @brief Unlinks the entry from every index chain and from the storage.
+     * @return The removed product.
+     */
+    IProductPtr take(Entry &entry)
+    {
+        if (unlink(entry, byKey))
+        {
+            byKey_.erase(entry.key);
+        }
+        unlink(entry, byClass);
+        if (unlink(entry, byName))
+        {
+            byName_.erase(entry.key.name);
+        }
+
+        auto product = std::move(entry.product);
+        items_.erase(entry.position);
+        return product;
+    }
+};
+
+}  // namespace warehouseInterface
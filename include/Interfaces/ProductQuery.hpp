@@ -0,0 +1,128 @@
+#pragma once
+#include <Interfaces/Aliases.hpp>
+#include <Interfaces/NamePool.hpp>
+#include <Interfaces/ProductClassTable.hpp>
+#include <PicoJson/picojson.h>
+#include <string>
+#include <vector>
+
+namespace warehouseInterface
+{
+/**
+ * @brief Typed product description compiled from ProductDescriptionJson. New predicates are added as fields whose default
+ * value matches any product.
+ * @param productClass Interned ID of the requested class, anyProductClass if the class is not considered in the matching.
+ * @param name Interned symbol of the requested name, anyName if the name is not considered in the matching.
+ * @param satisfiable false if the description requests a class or a name which was never interned, so no product can
+ * match it.
+ */
+struct ProductQuery
+{
+    ProductClassId productClass{anyProductClass};
+    NameSymbol name{anyName};
+    bool satisfiable{true};
+
+    /**
+     * @brief Compiles a product description JSON object. Fields which are missing or are not strings are not considered.
+     * @return The compiled query.
+     */
+    static ProductQuery compile(const picojson::value &description)
+    {
+        ProductQuery query{};
+        if (!description.is<picojson::object>())
+        {
+            return query;
+        }
+        const auto &object = description.get<picojson::object>();
+        const auto field = [&object](const std::string &key) {
+            const auto it = object.find(key);
+            return it != object.end() && it->second.is<std::string>() ? it->second.get<std::string>() : std::string{};
+        };
+
+        const auto className = field("class");
+        if (!className.empty())
+        {
+            query.productClass = ProductClassTable::instance().find(className);
+            query.satisfiable = query.productClass != anyProductClass;
+        }
+        const auto productName = field("name");
+        if (!productName.empty())
+        {
+            query.name = NamePool::instance().find(productName);
+            query.satisfiable = query.satisfiable && query.name != anyName;
+        }
+        return query;
+    }
+
+    /**
+     * @brief Compiles a serialized product description.
+     * @return The compiled query. A description which is not a valid JSON object cannot be satisfied.
+     */
+    static ProductQuery compile(const ProductDescriptionJson &description)
+    {
+        picojson::value json;
+        if (!picojson::parse(json, description).empty() || !json.is<picojson::object>())
+        {
+            return ProductQuery{anyProductClass, anyName, false};
+        }
+        return compile(json);
+    }
+
+    /**
+     * @brief Converts the query back to a product description, for departments which only support the string API.
+     * @return The serialized product description.
+     */
+    ProductDescriptionJson serialize() const
+    {
+        picojson::object description{};
+        if (productClass != anyProductClass)
+        {
+            description["class"] = picojson::value(ProductClassTable::instance().name(productClass));
+        }
+        if (name != anyName)
+        {
+            description["name"] = picojson::value(NamePool::instance().name(name));
+        }
+        return picojson::value(std::move(description)).serialize();
+    }
+};
+
+/**
+ * @brief Typed order compiled from OrderJson.
+ * @param lines Compiled queries of the requested products, in the order of the order JSON.
+ */
+struct OrderQuery
+{
+    std::vector<ProductQuery> lines;
+
+    /**
+     * @brief Compiles a serialized order. Lines which are not JSON objects are skipped.
+     * @return The compiled order, without any lines if the order is not valid.
+     */
+    static OrderQuery compile(const OrderJson &order)
+    {
+        OrderQuery query{};
+        picojson::value json;
+        if (!picojson::parse(json, order).empty() || !json.is<picojson::object>())
+        {
+            return query;
+        }
+        const auto &object = json.get<picojson::object>();
+        const auto lines = object.find("order");
+        if (lines == object.end() || !lines->second.is<picojson::array>())
+        {
+            return query;
+        }
+
+        for (const auto &line : lines->second.get<picojson::array>())
+        {
+            if (line.is<picojson::object>())
+            {
+                query.lines.push_back(ProductQuery::compile(line));
+            }
+        }
+        return query;
+    }
+};
+
+}  // namespace warehouseInterface
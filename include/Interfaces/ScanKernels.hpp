@@ -0,0 +1,243 @@
+#pragma once
+#include <Interfaces/NamePool.hpp>
+#include <Interfaces/ProductClassTable.hpp>
+#include <Interfaces/ProductFlags.hpp>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define WAREHOUSE_X86_KERNELS 1
+#endif
+
+namespace warehouseInterface
+{
+/**
+ * @brief Conditions a stored row has to meet. Every condition left at its default value matches any row.
+ * @param requiredFlags All these flags have to be set on the product.
+ * @param minSize, maxSize Inclusive range of the product size.
+ */
+struct RowFilter
+{
+    ProductClassId productClass{anyProductClass};
+    NameSymbol name{anyName};
+    unsigned requiredFlags{0};
+    float minSize{std::numeric_limits<float>::lowest()};
+    float maxSize{std::numeric_limits<float>::max()};
+};
+
+/**
+ * @brief Read-only view of the columns of a columnar storage. Rows with a nonzero reserved byte (reserved or removed
+ * rows) never match.
+ */
+struct ColumnsView
+{
+    const ProductClassId *classes{};
+    const NameSymbol *names{};
+    const float *sizes{};
+    const ProductLabelFlags *flags{};
+    const std::uint8_t *reserved{};
+};
+
+/**
+ * @brief Kernels scanning columns for the first row matching a RowFilter. The AVX2 kernel tests 8 rows per instruction,
+ * the SSE4.2 kernel 4 rows, and the scalar kernel one row; all of them return the same row. The best kernel the CPU
+ * supports is chosen once at runtime.
+ */
+class ScanKernels
+{
+public:
+    enum class Kernel
+    {
+        scalar,
+        sse42,
+        avx2
+    };
+
+    /**
+     * @brief Gets the kernel used by findFirst.
+     * @return The best kernel supported by the CPU.
+     */
+    static Kernel best()
+    {
+        static const auto kernel = detect();
+        return kernel;
+    }
+
+    /**
+     * @brief Finds the first row in [from, to) matching the filter, using the kernel if the CPU supports it and the
+     * scalar kernel otherwise.
+     * @return The position of the row, to if there is none.
+     */
+    static std::size_t findFirst(const ColumnsView &columns, std::size_t from, std::size_t to, const RowFilter &filter,
+                                 Kernel kernel = best())
+    {
+#if defined(WAREHOUSE_X86_KERNELS)
+        if (kernel == Kernel::avx2 && best() == Kernel::avx2)
+        {
+            from = findFirstAvx2(columns, from, to, filter);
+        }
+        else if (kernel != Kernel::scalar && best() != Kernel::scalar)
+        {
+            from = findFirstSse42(columns, from, to, filter);
+        }
+#else
+        static_cast<void>(kernel);
+#endif
+        return findFirstScalar(columns, from, to, filter);
+    }
+
+private:
+    static Kernel detect()
+    {
+#if defined(WAREHOUSE_X86_KERNELS)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return Kernel::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2"))
+        {
+            return Kernel::sse42;
+        }
+#endif
+        return Kernel::scalar;
+    }
+
+    static bool matches(const ColumnsView &columns, std::size_t row, const RowFilter &filter)
+    {
+        return !columns.reserved[row] &&
+               (filter.productClass == anyProductClass || columns.classes[row] == filter.productClass) &&
+               (filter.name == anyName || columns.names[row] == filter.name) &&
+               (static_cast<unsigned>(columns.flags[row]) & filter.requiredFlags) == filter.requiredFlags &&
+               columns.sizes[row] >= filter.minSize && columns.sizes[row] <= filter.maxSize;
+    }
+
+    static std::size_t findFirstScalar(const ColumnsView &columns, std::size_t from, std::size_t to, const RowFilter &filter)
+    {
+        while (from < to && !matches(columns, from, filter))
+        {
+            ++from;
+        }
+        return from;
+    }
+
+#if defined(WAREHOUSE_X86_KERNELS)
+    static_assert(sizeof(ProductClassId) == 2, "the SIMD kernels load 16-bit class IDs");
+    static_assert(sizeof(NameSymbol) == 4, "the SIMD kernels load 32-bit name symbols");
+    static_assert(sizeof(ProductLabelFlags) == 4, "the SIMD kernels load 32-bit flags");
+
+    /**
+     * @brief Skips the full blocks of 8 rows without a match. Only the columns tested by the filter are loaded, as the
+     * scan is bound by memory bandwidth.
+     * @return The first row of the block holding the first match, or of the remaining rows.
+     */
+    __attribute__((target("avx2"))) static std::size_t findFirstAvx2(const ColumnsView &columns, std::size_t from,
+                                                                     std::size_t to, const RowFilter &filter)
+    {
+        const bool testClass = filter.productClass != anyProductClass;
+        const bool testName = filter.name != anyName;
+        const bool testFlags = filter.requiredFlags != 0;
+        const bool testSize = filter.minSize > std::numeric_limits<float>::lowest() ||
+                              filter.maxSize < std::numeric_limits<float>::max();
+        const auto productClass = _mm256_set1_epi32(filter.productClass);
+        const auto name = _mm256_set1_epi32(static_cast<int>(filter.name));
+        const auto requiredFlags = _mm256_set1_epi32(static_cast<int>(filter.requiredFlags));
+        const auto minSize = _mm256_set1_ps(filter.minSize);
+        const auto maxSize = _mm256_set1_ps(filter.maxSize);
+        const auto zero = _mm256_setzero_si256();
+        for (; from + 8 <= to; from += 8)
+        {
+            const auto reserved =
+                    _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(columns.reserved + from)));
+            auto match = _mm256_cmpeq_epi32(reserved, zero);
+            if (testClass)
+            {
+                const auto classes =
+                        _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(columns.classes + from)));
+                match = _mm256_and_si256(match, _mm256_cmpeq_epi32(classes, productClass));
+            }
+            if (testName)
+            {
+                const auto names = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(columns.names + from));
+                match = _mm256_and_si256(match, _mm256_cmpeq_epi32(names, name));
+            }
+            if (testFlags)
+            {
+                const auto flags = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(columns.flags + from));
+                match = _mm256_and_si256(match, _mm256_cmpeq_epi32(_mm256_and_si256(flags, requiredFlags), requiredFlags));
+            }
+            auto mask = _mm256_movemask_ps(_mm256_castsi256_ps(match));
+            if (testSize && mask != 0)
+            {
+                const auto sizes = _mm256_loadu_ps(columns.sizes + from);
+                const auto sizeMatch =
+                        _mm256_and_ps(_mm256_cmp_ps(sizes, minSize, _CMP_GE_OQ), _mm256_cmp_ps(sizes, maxSize, _CMP_LE_OQ));
+                mask &= _mm256_movemask_ps(sizeMatch);
+            }
+            if (mask != 0)
+            {
+                return from + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+            }
+        }
+        return from;
+    }
+
+    /**
+     * @brief Skips the full blocks of 4 rows without a match, loading only the columns tested by the filter.
+     * @return The first row of the block holding the first match, or of the remaining rows.
+     */
+    __attribute__((target("sse4.2"))) static std::size_t findFirstSse42(const ColumnsView &columns, std::size_t from,
+                                                                       std::size_t to, const RowFilter &filter)
+    {
+        const bool testClass = filter.productClass != anyProductClass;
+        const bool testName = filter.name != anyName;
+        const bool testFlags = filter.requiredFlags != 0;
+        const bool testSize = filter.minSize > std::numeric_limits<float>::lowest() ||
+                              filter.maxSize < std::numeric_limits<float>::max();
+        const auto productClass = _mm_set1_epi32(filter.productClass);
+        const auto name = _mm_set1_epi32(static_cast<int>(filter.name));
+        const auto requiredFlags = _mm_set1_epi32(static_cast<int>(filter.requiredFlags));
+        const auto minSize = _mm_set1_ps(filter.minSize);
+        const auto maxSize = _mm_set1_ps(filter.maxSize);
+        const auto zero = _mm_setzero_si128();
+        for (; from + 4 <= to; from += 4)
+        {
+            std::int32_t reservedBytes{};
+            std::memcpy(&reservedBytes, columns.reserved + from, sizeof(reservedBytes));
+            auto match = _mm_cmpeq_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(reservedBytes)), zero);
+            if (testClass)
+            {
+                const auto classes =
+                        _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(columns.classes + from)));
+                match = _mm_and_si128(match, _mm_cmpeq_epi32(classes, productClass));
+            }
+            if (testName)
+            {
+                const auto names = _mm_loadu_si128(reinterpret_cast<const __m128i *>(columns.names + from));
+                match = _mm_and_si128(match, _mm_cmpeq_epi32(names, name));
+            }
+            if (testFlags)
+            {
+                const auto flags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(columns.flags + from));
+                match = _mm_and_si128(match, _mm_cmpeq_epi32(_mm_and_si128(flags, requiredFlags), requiredFlags));
+            }
+            auto mask = _mm_movemask_ps(_mm_castsi128_ps(match));
+            if (testSize && mask != 0)
+            {
+                const auto sizes = _mm_loadu_ps(columns.sizes + from);
+                mask &= _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(sizes, minSize), _mm_cmple_ps(sizes, maxSize)));
+            }
+            if (mask != 0)
+            {
+                return from + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+            }
+        }
+        return from;
+    }
+#endif
+};
+
+}  // namespace warehouseInterface
@@ -0,0 +1,144 @@
+#pragma once
+#include <Interfaces/IProduct.hpp>
+#include <Interfaces/ProductArena.hpp>
+#include <Products/ProductsList.hpp>
+#include <concepts>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+
+namespace warehouse
+{
+/**
+ * @brief Adapter holding a product of one of the built-in classes by value, e.g. in a std::vector without one allocation
+ * per product. The set of classes is closed, so name, itemSize, itemFlags and asJson dispatch with std::visit over the
+ * alternatives and call the class implementations directly instead of through the IProduct vtable. The rest of the
+ * product interface is reached through asProduct. The warehouse API and the departments keep handling products as
+ * IProductPtr (departments keep built-in products inline with the ColumnarStorage); toProductPtr and fromProduct convert
+ * between the two forms.
+ */
+class ProductValue
+{
+public:
+    using Variant = std::variant<AcetoneBarrel, AstronautsIceCream, ElectronicParts, ExplosiveBarrel, GlassWare,
+                                 IndustrialServerRack, TV>;
+
+    /**
+     * @brief Tells if the product class is one of the alternatives.
+     */
+    template <typename Product>
+    static constexpr bool holds = []<typename... Products>(std::type_identity<std::variant<Products...>>) {
+        return (std::same_as<Product, Products> || ...);
+    }(std::type_identity<Variant>{});
+
+private:
+    Variant value_;
+
+public:
+    template <typename Product>
+        requires holds<std::remove_cvref_t<Product>>
+    explicit ProductValue(Product &&product) : value_{std::forward<Product>(product)}
+    {
+    }
+
+    /**
+     * @brief Copies a product of a built-in class.
+     * @return The product value, nothing if the product is of another class.
+     */
+    static std::optional<ProductValue> fromProduct(const warehouseInterface::IProduct &product)
+    {
+        std::optional<ProductValue> value{};
+        [&]<typename... Products>(std::type_identity<std::variant<Products...>>) {
+            static_cast<void>(((value = copyIf<Products>(product)) || ...));
+        }(std::type_identity<Variant>{});
+        return value;
+    }
+
+    /**
+     * @brief Calls the visitor with the product as its concrete class.
+     * @return The result of the visitor.
+     */
+    template <typename Visitor>
+    decltype(auto) visit(Visitor &&visitor) const
+    {
+        return std::visit(std::forward<Visitor>(visitor), value_);
+    }
+
+    std::string name() const
+    {
+        return visit([](const auto &product) {
+            using Product = std::remove_cvref_t<decltype(product)>;
+            return product.Product::name();
+        });
+    }
+
+    float itemSize() const
+    {
+        return visit([](const auto &product) {
+            using Product = std::remove_cvref_t<decltype(product)>;
+            return product.Product::itemSize();
+        });
+    }
+
+    warehouseInterface::ProductLabelFlags itemFlags() const
+    {
+        return visit([](const auto &product) {
+            using Product = std::remove_cvref_t<decltype(product)>;
+            return product.Product::itemFlags();
+        });
+    }
+
+    picojson::object asJson() const
+    {
+        return visit([](const auto &product) {
+            using Product = std::remove_cvref_t<decltype(product)>;
+            return product.Product::asJson();
+        });
+    }
+
+    /**
+     * @brief Views the product through the IProduct interface, without copying it.
+     * @return The product, valid as long as the value.
+     */
+    const warehouseInterface::IProduct &asProduct() const
+    {
+        return visit([](const auto &product) -> const warehouseInterface::IProduct & { return product; });
+    }
+
+    /**
+     * @brief Copies the product into the ProductArena, for the API taking products as IProductPtr.
+     * @return The product pointer.
+     */
+    warehouseInterface::IProductPtr toProductPtr() const
+    {
+        return visit([](const auto &product) -> warehouseInterface::IProductPtr {
+            using Product = std::remove_cvref_t<decltype(product)>;
+            auto &bucket = warehouseInterface::ProductArena::instance().bucket(sizeof(Product));
+            auto *block = bucket.allocate();
+            try
+            {
+                return {::new (block) Product(product), warehouseInterface::ProductDeleter{bucket}};
+            }
+            catch (...)
+            {
+                bucket.deallocate(block);
+                throw;
+            }
+        });
+    }
+
+private:
+    template <typename Product>
+    static std::optional<ProductValue> copyIf(const warehouseInterface::IProduct &product)
+    {
+        const auto *concrete = dynamic_cast<const Product *>(&product);
+        return concrete && typeid(*concrete) == typeid(Product) ? std::optional<ProductValue>{ProductValue{*concrete}}
+                                                               : std::nullopt;
+    }
+};
+
+}  // namespace warehouse
@@ -0,0 +1,109 @@
+#pragma once
+#include <Interfaces/OccupancyCounter.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Max segment tree over the free capacities of a sequence of departments, in OccupancyCounter micro-units. It
+ * finds the first department, at or after a given slot, whose free capacity is at least the requested size in
+ * logarithmic time.
+ */
+class CapacityTree
+{
+public:
+    using Units = warehouseInterface::OccupancyCounter::Units;
+
+private:
+    static constexpr Units none = std::numeric_limits<Units>::min();
+
+    std::size_t size_{};
+    std::size_t leaves_{1};
+    std::vector<Units> nodes_ = std::vector<Units>(2, none);
+
+public:
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Gets the free capacity of the slot.
+     * @return The capacity.
+     */
+    Units capacity(std::size_t slot) const
+    {
+        return nodes_[leaves_ + slot];
+    }
+
+    /**
+     * @brief Appends a slot with the free capacity. The tree doubles its leaves when it is full.
+     * @return None.
+     */
+    void push_back(Units capacity)
+    {
+        if (size_ == leaves_)
+        {
+            std::vector<Units> nodes(4 * leaves_, none);
+            std::copy(nodes_.begin() + leaves_, nodes_.end(), nodes.begin() + 2 * leaves_);
+            leaves_ *= 2;
+            nodes_.swap(nodes);
+            for (auto node = leaves_ - 1; node > 0; --node)
+            {
+                nodes_[node] = std::max(nodes_[2 * node], nodes_[2 * node + 1]);
+            }
+        }
+        update(size_++, capacity);
+    }
+
+    /**
+     * @brief Sets the free capacity of the slot.
+     * @return None.
+     */
+    void update(std::size_t slot, Units capacity)
+    {
+        auto node = leaves_ + slot;
+        nodes_[node] = capacity;
+        for (node /= 2; node > 0; node /= 2)
+        {
+            nodes_[node] = std::max(nodes_[2 * node], nodes_[2 * node + 1]);
+        }
+    }
+
+    /**
+     * @brief Finds the first slot, not before the from slot, whose free capacity is at least the requested size.
+     * @return The slot, or size() if there is no such slot.
+     */
+    std::size_t findFirst(Units size, std::size_t from = 0) const
+    {
+        return from < size_ ? find(1, 0, leaves_, from, size) : size_;
+    }
+
+    void clear()
+    {
+        size_ = 0;
+        leaves_ = 1;
+        nodes_.assign(2, none);
+    }
+
+private:
+    std::size_t find(std::size_t node, std::size_t begin, std::size_t end, std::size_t from, Units size) const
+    {
+        if (end <= from || nodes_[node] < size)
+        {
+            return size_;
+        }
+        if (end - begin == 1)
+        {
+            return begin;
+        }
+        const auto middle = begin + (end - begin) / 2;
+        const auto slot = find(2 * node, begin, middle, from, size);
+        return slot != size_ ? slot : find(2 * node + 1, middle, end, from, size);
+    }
+};
+
+}  // namespace warehouse
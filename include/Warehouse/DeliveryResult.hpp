@@ -0,0 +1,63 @@
+#pragma once
+#include <PicoJson/picojson.h>
+#include <Warehouse/JsonWriter.hpp>
+#include <cstddef>
+#include <string>
+
+namespace warehouse
+{
+/**
+ * @brief Outcome of storing a single delivered product, the typed form of a delivery report entry.
+ * @param productName Name of the product, empty for an invalid product.
+ * @param department Position of the department storing the product in the warehouse, none if it was not stored.
+ * @param assignedDepartment Name of the department storing the product, "None" if it was not stored.
+ * @param errorLog Reason why the product was not stored, empty if it was stored.
+ */
+struct DeliveryResult
+{
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    std::string productName{};
+    std::size_t department{none};
+    std::string assignedDepartment{"None"};
+    const char *errorLog{""};
+
+    bool stored() const
+    {
+        return department != none;
+    }
+
+    /**
+     * @brief Converts the result to a delivery report entry.
+     * @return JSON object of the entry.
+     */
+    picojson::object asJson() const
+    {
+        picojson::object entry{};
+        entry["assignedDepartment"] = picojson::value(assignedDepartment);
+        entry["errorLog"] = picojson::value(errorLog);
+        entry["productName"] = picojson::value(productName);
+        entry["status"] = picojson::value(stored() ? "Success" : "Fail");
+        return entry;
+    }
+
+    /**
+     * @brief Writes the result as a delivery report entry, with the same bytes as the serialized asJson object.
+     * @return None.
+     */
+    void write(JsonWriter &writer) const
+    {
+        writer.beginObject()
+                .key("assignedDepartment")
+                .value(assignedDepartment)
+                .key("errorLog")
+                .value(errorLog)
+                .key("productName")
+                .value(productName)
+                .key("status")
+                .value(stored() ? "Success" : "Fail")
+                .endObject();
+    }
+};
+
+}  // namespace warehouse
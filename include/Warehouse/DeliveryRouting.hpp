@@ -0,0 +1,303 @@
+#pragma once
+#include <Interfaces/IDepartment.hpp>
+#include <Interfaces/ProductFlags.hpp>
+#include <Warehouse/CapacityTree.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Strategy choosing the department which stores a delivered product among the required departments with room.
+ * @param firstFit The very first department in the warehouse order, as required by IWarehouse.
+ * @param bestFit The department with the least free capacity left, so large free spaces stay available.
+ * @param worstFit The department with the most free capacity left, so the load is spread evenly.
+ * @param nextFit The first department after the one which stored the previous product of the same routing class,
+ * wrapping around to the first department.
+ */
+enum class PlacementPolicy
+{
+    firstFit,
+    bestFit,
+    worstFit,
+    nextFit
+};
+
+/**
+ * @brief Delivery routing table. The required department of a product depends only on the first group of its flags
+ * matching one of the routing classes, so for every routing class the table keeps the ordered list of departments (by
+ * their position in the warehouse) which can take such products, together with a capacity tree of these departments
+ * for first-fit and next-fit placement and an ordered set of their capacities for best-fit and worst-fit placement.
+ * Capacities and sizes are compared in OccupancyCounter micro-units, as the departments count their occupancy.
+ */
+class DeliveryRouting
+{
+public:
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Flag groups deciding about the required department, in the order of their priority: hazardous products,
+     * electronics, frozen products and products which need special care.
+     */
+    static constexpr std::array<unsigned, 4> groups = {
+            static_cast<unsigned>(warehouseInterface::ProductLabelFlags::explosives) |
+                    static_cast<unsigned>(warehouseInterface::ProductLabelFlags::fireHazardous),
+            static_cast<unsigned>(warehouseInterface::ProductLabelFlags::esdSensitive),
+            static_cast<unsigned>(warehouseInterface::ProductLabelFlags::keepFrozen),
+            static_cast<unsigned>(warehouseInterface::ProductLabelFlags::fragile) |
+                    static_cast<unsigned>(warehouseInterface::ProductLabelFlags::handleWithCare) |
+                    static_cast<unsigned>(warehouseInterface::ProductLabelFlags::upWard)};
+
+    /**
+     * @brief Number of routing classes: products without any of the group flags, then one class per group.
+     */
+    static constexpr std::size_t classesCount = groups.size() + 1;
+
+    /**
+     * @brief Next-fit starting slots of all routing classes.
+     */
+    using NextSlots = std::array<std::size_t, classesCount>;
+
+    using Units = warehouseInterface::OccupancyCounter::Units;
+
+private:
+    struct RoutingClass
+    {
+        std::vector<std::size_t> departments{};
+        CapacityTree capacities{};
+        std::set<std::pair<Units, std::size_t>> byCapacity{};
+        std::size_t nextSlot{0};
+        float largestItemSize{0.0f};
+    };
+
+    std::array<RoutingClass, classesCount> classes_{};
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> slots_{};
+
+public:
+    /**
+     * @brief Gets the flags which decide about the required department. Products without any of these flags can be
+     * stored in any department.
+     * @return The flags of the first group matching the product flags.
+     */
+    static unsigned requiredFlags(unsigned productFlags)
+    {
+        const auto routingClass = classOf(productFlags);
+        return routingClass == 0 ? 0 : groups[routingClass - 1];
+    }
+
+    /**
+     * @brief Checks if a department supporting the flags is the required department of products with the flags.
+     * @return true if the department can take such products (regardless of their size and its free space), false otherwise.
+     */
+    static bool supports(warehouseInterface::ProductLabelFlags supportedFlags, unsigned productFlags)
+    {
+        const auto required = requiredFlags(productFlags);
+        return required == 0 || (static_cast<unsigned>(supportedFlags) & required) != 0;
+    }
+
+    /**
+     * @brief Appends the department to every routing class it supports.
+     * @return None.
+     */
+    void addDepartment(const warehouseInterface::IDepartment &department, std::size_t position)
+    {
+        if (position >= slots_.size())
+        {
+            slots_.resize(position + 1);
+        }
+        for (std::size_t routingClass = 0; routingClass < classesCount; ++routingClass)
+        {
+            const auto required = routingClass == 0 ? 0 : groups[routingClass - 1];
+            if (required != 0 && (static_cast<unsigned>(department.getSupportedFlags()) & required) == 0)
+            {
+                continue;
+            }
+            auto &entry = classes_[routingClass];
+            const auto capacity = capacityOf(department, department.occupancyUnits());
+            slots_[position].emplace_back(routingClass, entry.departments.size());
+            entry.byCapacity.emplace(capacity, entry.departments.size());
+            entry.departments.push_back(position);
+            entry.capacities.push_back(capacity);
+            entry.largestItemSize = std::max(entry.largestItemSize, department.getMaxItemSize());
+        }
+    }
+
+    /**
+     * @brief Refreshes the free capacity of the department after its occupancy changed.
+     * @return None.
+     */
+    void update(const warehouseInterface::IDepartment &department, std::size_t position)
+    {
+        update(department, position, department.occupancyUnits());
+    }
+
+    /**
+     * @brief Sets the free capacity of the department as if its occupancy was the given one (in micro-units), for
+     * tentative placements.
+     * @return None.
+     */
+    void update(const warehouseInterface::IDepartment &department, std::size_t position, Units occupancy)
+    {
+        if (position >= slots_.size())
+        {
+            return;
+        }
+        const auto capacity = capacityOf(department, occupancy);
+        for (const auto &[routingClass, slot] : slots_[position])
+        {
+            auto &entry = classes_[routingClass];
+            entry.byCapacity.erase({entry.capacities.capacity(slot), slot});
+            entry.byCapacity.emplace(capacity, slot);
+            entry.capacities.update(slot, capacity);
+        }
+    }
+
+    /**
+     * @brief Gets the departments which are required by products with the flags.
+     * @return Department positions in the warehouse order.
+     */
+    const std::vector<std::size_t> &candidates(warehouseInterface::ProductLabelFlags productFlags) const
+    {
+        return classes_[classOf(static_cast<unsigned>(productFlags))].departments;
+    }
+
+    /**
+     * @brief Chooses the department storing a product of the size (in micro-units) according to the policy. The free
+     * space is indexed exactly, but the departments compare the maximal item size as a float and may have conditions of
+     * their own, so every chosen candidate is confirmed by the accepts predicate (IDepartment::canAdd) before the next
+     * one is considered.
+     * @return Position of the first accepted department in the policy order, none if no department was accepted.
+     */
+    template <typename Accepts>
+    std::size_t place(warehouseInterface::ProductLabelFlags productFlags, Units size, PlacementPolicy policy,
+                      Accepts &&accepts)
+    {
+        auto &entry = classes_[classOf(static_cast<unsigned>(productFlags))];
+        const auto slot = choose(entry, size, policy, [&entry, &accepts](std::size_t slot) {
+            return accepts(entry.departments[slot]);
+        });
+        if (slot == none)
+        {
+            return none;
+        }
+        entry.nextSlot = slot;
+        return entry.departments[slot];
+    }
+
+    /**
+     * @brief Checks if any department required by products with the flags accepts items of the size.
+     * @return true if such a department exists, false otherwise.
+     */
+    bool hasRequiredDepartment(warehouseInterface::ProductLabelFlags productFlags, float size) const
+    {
+        const auto &entry = classes_[classOf(static_cast<unsigned>(productFlags))];
+        return !entry.departments.empty() && size <= entry.largestItemSize;
+    }
+
+    NextSlots nextSlots() const
+    {
+        NextSlots slots{};
+        for (std::size_t routingClass = 0; routingClass < classesCount; ++routingClass)
+        {
+            slots[routingClass] = classes_[routingClass].nextSlot;
+        }
+        return slots;
+    }
+
+    void restoreNextSlots(const NextSlots &slots)
+    {
+        for (std::size_t routingClass = 0; routingClass < classesCount; ++routingClass)
+        {
+            classes_[routingClass].nextSlot = slots[routingClass];
+        }
+    }
+
+    void clear()
+    {
+        classes_ = {};
+        slots_.clear();
+    }
+
+private:
+    template <typename Accepts>
+    static std::size_t choose(const RoutingClass &entry, Units size, PlacementPolicy policy, const Accepts &accepts)
+    {
+        const auto &capacities = entry.capacities;
+        const auto scan = [&capacities, &accepts, size](std::size_t from, std::size_t end) {
+            for (auto slot = capacities.findFirst(size, from); slot < end; slot = capacities.findFirst(size, slot + 1))
+            {
+                if (accepts(slot))
+                {
+                    return slot;
+                }
+            }
+            return none;
+        };
+
+        switch (policy)
+        {
+        case PlacementPolicy::bestFit:
+            for (auto it = entry.byCapacity.lower_bound({size, 0}); it != entry.byCapacity.end(); ++it)
+            {
+                if (accepts(it->second))
+                {
+                    return it->second;
+                }
+            }
+            return none;
+        case PlacementPolicy::worstFit:
+            // Walks the capacities from the largest one, visiting departments with equal capacities in the warehouse order.
+            for (auto end = entry.byCapacity.end(); end != entry.byCapacity.begin() && std::prev(end)->first >= size;)
+            {
+                const auto begin = entry.byCapacity.lower_bound({std::prev(end)->first, 0});
+                for (auto it = begin; it != end; ++it)
+                {
+                    if (accepts(it->second))
+                    {
+                        return it->second;
+                    }
+                }
+                end = begin;
+            }
+            return none;
+        case PlacementPolicy::nextFit:
+        {
+            const auto slot = scan(entry.nextSlot, capacities.size());
+            return slot != none ? slot : scan(0, entry.nextSlot);
+        }
+        case PlacementPolicy::firstFit:
+        default:
+            return scan(0, capacities.size());
+        }
+    }
+
+    static std::size_t classOf(unsigned productFlags)
+    {
+        for (std::size_t group = 0; group < groups.size(); ++group)
+        {
+            if (productFlags & groups[group])
+            {
+                return group + 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Gets the largest product the department can take at the occupancy: its free space, limited by its maximal
+     * item size.
+     * @return The capacity in micro-units.
+     */
+    static Units capacityOf(const warehouseInterface::IDepartment &department, Units occupancy)
+    {
+        const auto maxItemSize = warehouseInterface::OccupancyCounter::toUnits(department.getMaxItemSize());
+        return std::min(department.maxOccupancyUnits() - occupancy, maxItemSize);
+    }
+};
+
+}  // namespace warehouse
@@ -0,0 +1,225 @@
+#pragma once
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Writes JSON straight into a string buffer, producing the same bytes as picojson::value::serialize without
+ * building a document. Keys are written in the order of the calls, so callers write them alphabetically to match
+ * picojson objects. Nesting is tracked in a bit mask, so writing does not allocate once the buffer is reserved; levels
+ * deeper than 64 spill into a vector.
+ */
+class JsonWriter
+{
+    std::string buffer_{};
+    std::uint64_t nonEmpty_{};
+    std::vector<std::uint64_t> deeperNonEmpty_{};
+    unsigned depth_{};
+    bool afterKey_{false};
+
+public:
+    explicit JsonWriter(std::size_t capacity = 0)
+    {
+        buffer_.reserve(capacity);
+    }
+
+    JsonWriter &beginObject()
+    {
+        return open('{');
+    }
+
+    JsonWriter &endObject()
+    {
+        return close('}');
+    }
+
+    JsonWriter &beginArray()
+    {
+        return open('[');
+    }
+
+    JsonWriter &endArray()
+    {
+        return close(']');
+    }
+
+    JsonWriter &key(std::string_view name)
+    {
+        separate();
+        writeString(name);
+        buffer_ += ':';
+        afterKey_ = true;
+        return *this;
+    }
+
+    JsonWriter &value(std::string_view text)
+    {
+        separate();
+        writeString(text);
+        return *this;
+    }
+
+    JsonWriter &value(const char *text)
+    {
+        return value(std::string_view{text});
+    }
+
+    /**
+     * @brief Writes a number: integral values below 2^53 without a fraction, other values with 17 significant digits.
+     * @return The writer.
+     */
+    JsonWriter &value(double number)
+    {
+        separate();
+        char text[32];
+        double integral;
+        const auto integer = std::fabs(number) < 9007199254740992.0 && std::modf(number, &integral) == 0;
+        const auto end = integer ? std::to_chars(text, text + sizeof(text), number, std::chars_format::fixed, 0).ptr
+                                 : std::to_chars(text, text + sizeof(text), number, std::chars_format::general, 17).ptr;
+        buffer_.append(text, end);
+        return *this;
+    }
+
+    /**
+     * @brief Writes an already serialized JSON value.
+     * @return The writer.
+     */
+    JsonWriter &raw(std::string_view json)
+    {
+        separate();
+        buffer_ += json;
+        return *this;
+    }
+
+    const std::string &str() const &
+    {
+        return buffer_;
+    }
+
+    std::string str() &&
+    {
+        return std::move(buffer_);
+    }
+
+private:
+    JsonWriter &open(char bracket)
+    {
+        separate();
+        buffer_ += bracket;
+        ++depth_;
+        nonEmptyWord() &= ~(std::uint64_t{1} << (depth_ % 64));
+        return *this;
+    }
+
+    JsonWriter &close(char bracket)
+    {
+        buffer_ += bracket;
+        --depth_;
+        return *this;
+    }
+
+    void separate()
+    {
+        if (afterKey_)
+        {
+            afterKey_ = false;
+            return;
+        }
+        auto &nonEmpty = nonEmptyWord();
+        const auto bit = std::uint64_t{1} << (depth_ % 64);
+        if (depth_ > 0 && (nonEmpty & bit))
+        {
+            buffer_ += ',';
+        }
+        nonEmpty |= bit;
+    }
+
+    /**
+     * @brief Gets the word of the nesting bit mask holding the current level.
+     * @return The mask word.
+     */
+    std::uint64_t &nonEmptyWord()
+    {
+        if (depth_ < 64)
+        {
+            return nonEmpty_;
+        }
+        const auto word = depth_ / 64 - 1;
+        if (word >= deeperNonEmpty_.size())
+        {
+            deeperNonEmpty_.resize(word + 1);
+        }
+        return deeperNonEmpty_[word];
+    }
+
+    /**
+     * @brief Writes a string literal escaped like picojson: quotes, backslashes, slashes and control characters.
+     * @return None.
+     */
+    void writeString(std::string_view text)
+    {
+        buffer_ += '"';
+        std::size_t begin = 0;
+        for (std::size_t position = 0; position < text.size(); ++position)
+        {
+            const auto character = static_cast<unsigned char>(text[position]);
+            const char *escaped = nullptr;
+            switch (character)
+            {
+            case '"':
+                escaped = "\\\"";
+                break;
+            case '\\':
+                escaped = "\\\\";
+                break;
+            case '/':
+                escaped = "\\/";
+                break;
+            case '\b':
+                escaped = "\\b";
+                break;
+            case '\f':
+                escaped = "\\f";
+                break;
+            case '\n':
+                escaped = "\\n";
+                break;
+            case '\r':
+                escaped = "\\r";
+                break;
+            case '\t':
+                escaped = "\\t";
+                break;
+            default:
+                if (character >= 0x20 && character != 0x7f)
+                {
+                    continue;
+                }
+            }
+
+            buffer_.append(text, begin, position - begin);
+            begin = position + 1;
+            if (escaped)
+            {
+                buffer_ += escaped;
+            }
+            else
+            {
+                char unicode[7];
+                std::snprintf(unicode, sizeof(unicode), "\\u%04x", character);
+                buffer_ += unicode;
+            }
+        }
+        buffer_.append(text, begin, text.size() - begin);
+        buffer_ += '"';
+    }
+};
+
+}  // namespace warehouse
@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace warehouse
+{
+/**
+ * @brief Bounded lock-free multi-producer single-consumer ring. Every cell carries a sequence number: a producer claims a
+ * ticket with one fetch-add and publishes the value by advancing the cell sequence, the consumer takes the value once
+ * the sequence says it is published and hands the cell back to the producers one lap later. A producer that finds the
+ * ring full yields until the consumer frees its cell.
+ */
+template <typename T>
+class MpscRing
+{
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{};
+        T value{};
+    };
+
+    static constexpr std::size_t cacheLine = 64;
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(cacheLine) std::atomic<std::size_t> tail_{0};
+    alignas(cacheLine) std::size_t head_{0};
+
+public:
+    /**
+     * @param capacity Number of cells, rounded up to a power of two.
+     */
+    explicit MpscRing(std::size_t capacity) : mask_{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1}
+    {
+        cells_ = std::make_unique<Cell[]>(mask_ + 1);
+        for (std::size_t cell = 0; cell <= mask_; ++cell)
+        {
+            cells_[cell].sequence.store(cell, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    /**
+     * @brief Appends the value, waiting for a free cell if the ring is full. Safe to call from any thread.
+     * @return None.
+     */
+    void push(T value)
+    {
+        const auto ticket = tail_.fetch_add(1, std::memory_order_relaxed);
+        auto &cell = cells_[ticket & mask_];
+        while (cell.sequence.load(std::memory_order_acquire) != ticket)
+        {
+            std::this_thread::yield();
+        }
+        cell.value = std::move(value);
+        cell.sequence.store(ticket + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Takes the oldest published value. Must only be called from the consumer thread.
+     * @return The value, or nothing if no value is published yet.
+     */
+    std::optional<T> tryPop()
+    {
+        auto &cell = cells_[head_ & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1)
+        {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(cell.value)};
+        cell.value = T{};
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return value;
+    }
+};
+
+}  // namespace warehouse
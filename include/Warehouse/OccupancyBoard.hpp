@@ -0,0 +1,186 @@
+#pragma once
+#include <Interfaces/IDepartment.hpp>
+#include <Interfaces/OccupancyCounter.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Immutable point-in-time view of the occupancy of all departments. Descriptions and occupancies are kept in
+ * chunks shared with the previous snapshots, so publishing a change copies only the chunks it touches.
+ * @param descriptions Names and maximal occupancies of the departments in the warehouse order, chunkSize departments
+ * per chunk.
+ * @param chunks Occupancies in micro-units, chunkSize departments per chunk.
+ * @param departments Number of departments.
+ * @param version Number of changes published before this snapshot.
+ */
+struct OccupancySnapshot
+{
+    static constexpr std::size_t chunkSize = 256;
+
+    struct Department
+    {
+        std::string name{};
+        float maxOccupancy{};
+    };
+    using Descriptions = std::vector<Department>;
+    using Chunk = std::array<warehouseInterface::OccupancyCounter::Units, chunkSize>;
+
+    std::vector<std::shared_ptr<const Descriptions>> descriptions{};
+    std::vector<std::shared_ptr<const Chunk>> chunks{};
+    std::size_t departments{0};
+    std::uint64_t version{0};
+
+    const Department &department(std::size_t position) const
+    {
+        return (*descriptions[position / chunkSize])[position % chunkSize];
+    }
+
+    float occupancy(std::size_t position) const
+    {
+        return warehouseInterface::OccupancyCounter::toSize((*chunks[position / chunkSize])[position % chunkSize]);
+    }
+};
+
+/**
+ * @brief Read-copy-update publisher of occupancy snapshots. Writers describe their mutations as occupancy deltas and
+ * publish them once the mutations are done; the deltas of a publication are applied to a copy of the current snapshot,
+ * which then replaces it atomically. Readers only load the current snapshot, so they never wait for writers and never
+ * make them wait. Occupancy deltas commute, so every snapshot is the state after a set of completed publications.
+ */
+class OccupancyBoard
+{
+public:
+    /**
+     * @brief Occupancy changes of a warehouse call: department position and change in micro-units.
+     */
+    using Deltas = std::vector<std::pair<std::size_t, warehouseInterface::OccupancyCounter::Units>>;
+
+private:
+    std::mutex publishMutex_{};
+    std::atomic<std::shared_ptr<const OccupancySnapshot>> current_{std::make_shared<const OccupancySnapshot>()};
+
+public:
+    /**
+     * @brief Gets the latest published snapshot.
+     * @return The snapshot, which stays valid as long as the pointer is held.
+     */
+    std::shared_ptr<const OccupancySnapshot> snapshot() const
+    {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Appends the department with its current occupancy. Only the last chunks are copied.
+     * @return None.
+     */
+    void addDepartment(const warehouseInterface::IDepartment &department)
+    {
+        std::lock_guard lock{publishMutex_};
+        auto next = std::make_shared<OccupancySnapshot>(*current_.load(std::memory_order_relaxed));
+        const auto position = next->departments++;
+        const auto newChunk = position % OccupancySnapshot::chunkSize == 0;
+        auto *descriptions = newChunk ? appendDescriptions(*next) : copyDescriptions(*next, position);
+        descriptions->push_back({department.departmentName(), department.getMaxOccupancy()});
+
+        auto *chunk = newChunk ? appendChunk(*next) : copyChunk(*next, position);
+        (*chunk)[position % OccupancySnapshot::chunkSize] = department.occupancyUnits();
+        ++next->version;
+        current_.store(std::move(next), std::memory_order_release);
+    }
+
+    /**
+     * @brief Replaces all departments, after the warehouse state was loaded.
+     * @return None.
+     */
+    void reset(const std::vector<warehouseInterface::IDepartmentPtr> &departments)
+    {
+        auto next = std::make_shared<OccupancySnapshot>();
+        OccupancySnapshot::Descriptions *descriptions = nullptr;
+        OccupancySnapshot::Chunk *chunk = nullptr;
+        for (std::size_t position = 0; position < departments.size(); ++position)
+        {
+            const auto &department = *departments[position];
+            const auto newChunk = position % OccupancySnapshot::chunkSize == 0;
+            descriptions = newChunk ? appendDescriptions(*next) : descriptions;
+            descriptions->push_back({department.departmentName(), department.getMaxOccupancy()});
+            chunk = newChunk ? appendChunk(*next) : chunk;
+            (*chunk)[position % OccupancySnapshot::chunkSize] = department.occupancyUnits();
+        }
+        next->departments = departments.size();
+
+        std::lock_guard lock{publishMutex_};
+        next->version = current_.load(std::memory_order_relaxed)->version + 1;
+        current_.store(std::move(next), std::memory_order_release);
+    }
+
+    /**
+     * @brief Publishes the occupancy changes of a completed warehouse call as a new snapshot.
+     * @return None.
+     */
+    void publish(const Deltas &deltas)
+    {
+        if (deltas.empty())
+        {
+            return;
+        }
+        std::lock_guard lock{publishMutex_};
+        auto next = std::make_shared<OccupancySnapshot>(*current_.load(std::memory_order_relaxed));
+        std::unordered_map<std::size_t, OccupancySnapshot::Chunk *> copies{};
+        for (const auto &[position, units] : deltas)
+        {
+            auto &chunk = copies[position / OccupancySnapshot::chunkSize];
+            chunk = chunk ? chunk : copyChunk(*next, position);
+            (*chunk)[position % OccupancySnapshot::chunkSize] += units;
+        }
+        ++next->version;
+        current_.store(std::move(next), std::memory_order_release);
+    }
+
+private:
+    static OccupancySnapshot::Descriptions *appendDescriptions(OccupancySnapshot &snapshot)
+    {
+        auto descriptions = std::make_shared<OccupancySnapshot::Descriptions>();
+        descriptions->reserve(OccupancySnapshot::chunkSize);
+        auto *data = descriptions.get();
+        snapshot.descriptions.push_back(std::move(descriptions));
+        return data;
+    }
+
+    static OccupancySnapshot::Descriptions *copyDescriptions(OccupancySnapshot &snapshot, std::size_t position)
+    {
+        auto &shared = snapshot.descriptions[position / OccupancySnapshot::chunkSize];
+        auto descriptions = std::make_shared<OccupancySnapshot::Descriptions>(*shared);
+        descriptions->reserve(OccupancySnapshot::chunkSize);
+        auto *data = descriptions.get();
+        shared = std::move(descriptions);
+        return data;
+    }
+
+    static OccupancySnapshot::Chunk *appendChunk(OccupancySnapshot &snapshot)
+    {
+        auto chunk = std::make_shared<OccupancySnapshot::Chunk>();
+        auto *data = chunk.get();
+        snapshot.chunks.push_back(std::move(chunk));
+        return data;
+    }
+
+    static OccupancySnapshot::Chunk *copyChunk(OccupancySnapshot &snapshot, std::size_t position)
+    {
+        auto chunk = std::make_shared<OccupancySnapshot::Chunk>(*snapshot.chunks[position / OccupancySnapshot::chunkSize]);
+        auto *data = chunk.get();
+        snapshot.chunks[position / OccupancySnapshot::chunkSize] = std::move(chunk);
+        return data;
+    }
+};
+
+}  // namespace warehouse
@@ -0,0 +1,208 @@
+#pragma once
+#include <Interfaces/IWarehouse.hpp>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Asynchronous front end of a warehouse. Submitted orders are queued and served by an internal executor thread,
+ * which takes all queued orders at once (up to maxBatch) and fulfils them with a single newOrders call, in the order
+ * of submission. The warehouse must not be used by other threads at the same time unless it is thread-safe.
+ */
+class OrderGateway
+{
+public:
+    /**
+     * @brief Called on the executor thread with the fulfilled order, or with the exception thrown while fulfilling it.
+     * Exceptions thrown by the completion are ignored, so they never stop the executor.
+     */
+    using Completion = std::function<void(std::exception_ptr, warehouseInterface::Order)>;
+
+    static constexpr std::size_t maxBatch = 256;
+
+    /**
+     * @brief Awaitable result of an order. The awaiting coroutine is resumed on the executor thread.
+     */
+    class OrderAwaiter
+    {
+        OrderGateway &gateway_;
+        warehouseInterface::OrderJson order_;
+        std::exception_ptr error_{};
+        std::optional<warehouseInterface::Order> result_{};
+
+    public:
+        OrderAwaiter(OrderGateway &gateway, warehouseInterface::OrderJson order)
+            : gateway_{gateway}, order_{std::move(order)}
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            auto resume = [this, handle](std::exception_ptr error, warehouseInterface::Order order) {
+                error_ = error;
+                result_.emplace(std::move(order));
+                handle.resume();
+            };
+            gateway_.submitOrder(std::move(order_), std::move(resume));
+        }
+
+        warehouseInterface::Order await_resume()
+        {
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+            return std::move(*result_);
+        }
+    };
+
+private:
+    struct Request
+    {
+        warehouseInterface::OrderJson order;
+        Completion completion;
+    };
+
+    warehouseInterface::IWarehouse &warehouse_;
+    std::mutex mutex_{};
+    std::condition_variable ready_{};
+    std::deque<Request> requests_{};
+    bool stopping_{false};
+    std::jthread executor_{};
+
+public:
+    explicit OrderGateway(warehouseInterface::IWarehouse &warehouse) : warehouse_{warehouse}
+    {
+        executor_ = std::jthread{[this] { serve(); }};
+    }
+
+    OrderGateway(const OrderGateway &) = delete;
+    OrderGateway &operator=(const OrderGateway &) = delete;
+
+    /**
+     * @brief Serves all submitted orders and stops the executor.
+     */
+    ~OrderGateway()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stopping_ = true;
+        }
+        ready_.notify_one();
+    }
+
+    /**
+     * @brief Submits an order and returns immediately.
+     * @return Future of the fulfilled order.
+     */
+    std::future<warehouseInterface::Order> submitOrder(warehouseInterface::OrderJson order)
+    {
+        auto promise = std::make_shared<std::promise<warehouseInterface::Order>>();
+        auto future = promise->get_future();
+        submitOrder(std::move(order), [promise](std::exception_ptr error, warehouseInterface::Order fulfilled) {
+            if (error)
+            {
+                promise->set_exception(error);
+                return;
+            }
+            promise->set_value(std::move(fulfilled));
+        });
+        return future;
+    }
+
+    /**
+     * @brief Submits an order and returns immediately. The completion is called on the executor thread.
+     * @return None.
+     */
+    void submitOrder(warehouseInterface::OrderJson order, Completion completion)
+    {
+        {
+            std::lock_guard lock{mutex_};
+            requests_.push_back({std::move(order), std::move(completion)});
+        }
+        ready_.notify_one();
+    }
+
+    /**
+     * @brief Submits an order from a coroutine: co_await gateway.awaitOrder(order) gives the fulfilled order.
+     * @return The awaitable.
+     */
+    OrderAwaiter awaitOrder(warehouseInterface::OrderJson order)
+    {
+        return OrderAwaiter{*this, std::move(order)};
+    }
+
+private:
+    void serve()
+    {
+        std::vector<Request> batch{};
+        std::vector<warehouseInterface::OrderJson> orders{};
+        while (true)
+        {
+            {
+                std::unique_lock lock{mutex_};
+                ready_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+                if (requests_.empty())
+                {
+                    return;
+                }
+                while (!requests_.empty() && batch.size() < maxBatch)
+                {
+                    batch.push_back(std::move(requests_.front()));
+                    requests_.pop_front();
+                }
+            }
+
+            orders.clear();
+            for (auto &request : batch)
+            {
+                orders.push_back(std::move(request.order));
+            }
+            std::vector<warehouseInterface::Order> fulfilled{};
+            std::exception_ptr error{};
+            try
+            {
+                fulfilled = warehouse_.newOrders(orders);
+                if (fulfilled.size() != batch.size())
+                {
+                    throw std::length_error("Warehouse did not fulfil every order of the batch.");
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            for (std::size_t request = 0; request < batch.size(); ++request)
+            {
+                try
+                {
+                    batch[request].completion(error, error ? warehouseInterface::Order{} : std::move(fulfilled[request]));
+                }
+                catch (...)
+                {
+                }
+            }
+            batch.clear();
+        }
+    }
+};
+
+}  // namespace warehouse
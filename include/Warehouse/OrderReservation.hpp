@@ -0,0 +1,41 @@
+#pragma once
+#include <Interfaces/Aliases.hpp>
+#include <Interfaces/ProductIndex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Products reserved for an order, one per order line, waiting to be committed or released as a whole. It is
+ * move-only and committing or releasing it consumes it, so its reservations are ended once.
+ * @param receipt The reserved order.
+ * @param lines Department position and reservation of every reserved product, in the order of the order lines.
+ * @param generation Warehouse state the reservations belong to. Loading a state drops all reservations.
+ */
+struct OrderReservation
+{
+    struct Line
+    {
+        std::size_t department{};
+        warehouseInterface::ProductIndex::Reservation item{};
+    };
+
+    warehouseInterface::OrderJson receipt{};
+    std::vector<Line> lines{};
+    std::uint64_t generation{};
+
+    OrderReservation(warehouseInterface::OrderJson orderJson, std::uint64_t stateGeneration)
+        : receipt{std::move(orderJson)}, generation{stateGeneration}
+    {
+    }
+
+    OrderReservation(const OrderReservation &) = delete;
+    OrderReservation &operator=(const OrderReservation &) = delete;
+    OrderReservation(OrderReservation &&) = default;
+    OrderReservation &operator=(OrderReservation &&) = default;
+};
+
+}  // namespace warehouse
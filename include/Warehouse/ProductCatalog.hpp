@@ -0,0 +1,135 @@
+#pragma once
+#include <Interfaces/ProductIndex.hpp>
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Warehouse-wide catalog of the stock. For every product class ID, product name symbol and (class, name) pair it keeps the
+ * ordered set of departments (by their position in the warehouse) currently holding matching products, together with the
+ * number of such products, so orders visit only the departments which actually hold the requested item.
+ */
+class ProductCatalog
+{
+public:
+    /**
+     * @brief Departments holding matching stock: department position -> number of matching products.
+     */
+    using DepartmentsStock = std::map<std::size_t, std::size_t>;
+
+private:
+    std::unordered_map<warehouseInterface::ProductKey, DepartmentsStock, warehouseInterface::ProductKeyHash> byKey_{};
+    std::vector<DepartmentsStock> byClass_{};
+    std::unordered_map<warehouseInterface::NameSymbol, DepartmentsStock> byName_{};
+    DepartmentsStock all_{};
+
+public:
+    /**
+     * @brief Registers a product stored in the department.
+     * @return None.
+     */
+    void add(const warehouseInterface::ProductKey &key, std::size_t department)
+    {
+        ++byKey_[key][department];
+        if (key.productClass >= byClass_.size())
+        {
+            byClass_.resize(key.productClass + 1);
+        }
+        ++byClass_[key.productClass][department];
+        ++byName_[key.name][department];
+        ++all_[department];
+    }
+
+    /**
+     * @brief Unregisters a product taken from the department.
+     * @return None.
+     */
+    void remove(const warehouseInterface::ProductKey &key, std::size_t department)
+    {
+        release(byKey_, key, department);
+        if (key.productClass < byClass_.size())
+        {
+            decrement(byClass_[key.productClass], department);
+        }
+        release(byName_, key.name, department);
+        decrement(all_, department);
+    }
+
+    /**
+     * @brief Finds departments holding products matching the class and the name. The anyProductClass class or the anyName
+     * name is not considered in the matching.
+     * @return The departments holding matching stock ordered by their position in the warehouse, nullptr if there is none.
+     */
+    const DepartmentsStock *departmentsHolding(warehouseInterface::ProductClassId productClass,
+                                               warehouseInterface::NameSymbol name) const
+    {
+        if (productClass != warehouseInterface::anyProductClass && name != warehouseInterface::anyName)
+        {
+            return find(byKey_, warehouseInterface::ProductKey{productClass, name});
+        }
+        if (productClass != warehouseInterface::anyProductClass)
+        {
+            return productClass < byClass_.size() && !byClass_[productClass].empty() ? &byClass_[productClass] : nullptr;
+        }
+        if (name != warehouseInterface::anyName)
+        {
+            return find(byName_, name);
+        }
+        return all_.empty() ? nullptr : &all_;
+    }
+
+    /**
+     * @brief Checks if the department holds products matching the class and the name.
+     * @return true if the department holds matching stock, false otherwise.
+     */
+    bool holds(warehouseInterface::ProductClassId productClass, warehouseInterface::NameSymbol name, std::size_t department) const
+    {
+        const auto *stock = departmentsHolding(productClass, name);
+        return stock && stock->contains(department);
+    }
+
+    void clear()
+    {
+        byKey_.clear();
+        byClass_.clear();
+        byName_.clear();
+        all_.clear();
+    }
+
+private:
+    template <typename Map, typename Key>
+    static const DepartmentsStock *find(const Map &map, const Key &key)
+    {
+        const auto stock = map.find(key);
+        return stock != map.end() ? &stock->second : nullptr;
+    }
+
+    template <typename Map, typename Key>
+    static void release(Map &map, const Key &key, std::size_t department)
+    {
+        const auto stock = map.find(key);
+        if (stock == map.end())
+        {
+            return;
+        }
+        decrement(stock->second, department);
+        if (stock->second.empty())
+        {
+            map.erase(stock);
+        }
+    }
+
+    static void decrement(DepartmentsStock &stock, std::size_t department)
+    {
+        const auto count = stock.find(department);
+        if (count != stock.end() && --count->second == 0)
+        {
+            stock.erase(count);
+        }
+    }
+};
+
+}  // namespace warehouse
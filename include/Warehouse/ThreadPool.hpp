@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace warehouse
+{
+/**
+ * @brief Fixed-size pool of worker threads for data-parallel loops. The thread calling parallelFor works on its share of
+ * the loop too, so a pool of N workers runs the loop on N + 1 threads.
+ */
+class ThreadPool
+{
+    std::mutex mutex_{};
+    std::condition_variable ready_{};
+    std::deque<std::function<void()>> tasks_{};
+    bool stopping_{false};
+    std::vector<std::jthread> workers_{};
+
+public:
+    explicit ThreadPool(std::size_t workers)
+    {
+        workers_.reserve(workers);
+        for (std::size_t worker = 0; worker < workers; ++worker)
+        {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stopping_ = true;
+        }
+        ready_.notify_all();
+    }
+
+    std::size_t workers() const
+    {
+        return workers_.size();
+    }
+
+    /**
+     * @brief Calls the body for every index in [0, count), splitting the range into one contiguous chunk per thread, and
+     * waits until all chunks are done. The first exception thrown by the body is rethrown after all chunks finished.
+     * @return None.
+     */
+    template <typename Body>
+    void parallelFor(std::size_t count, const Body &body)
+    {
+        const auto chunks = std::min(count, workers_.size() + 1);
+        if (chunks <= 1)
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                body(index);
+            }
+            return;
+        }
+
+        std::latch done{static_cast<std::ptrdiff_t>(chunks)};
+        std::mutex errorMutex{};
+        std::exception_ptr error{};
+        const auto runChunk = [&, count, chunks](std::size_t chunk) {
+            try
+            {
+                for (auto index = count * chunk / chunks; index < count * (chunk + 1) / chunks; ++index)
+                {
+                    body(index);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock{errorMutex};
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+            done.count_down();
+        };
+
+        {
+            std::lock_guard lock{mutex_};
+            for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+            {
+                tasks_.emplace_back([&runChunk, chunk] { runChunk(chunk); });
+            }
+        }
+        ready_.notify_all();
+        runChunk(0);
+        done.wait();
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    void work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock{mutex_};
+                ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+}  // namespace warehouse
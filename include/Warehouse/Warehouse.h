@@ -1,11 +1,935 @@
+#pragma once
+#include <Departments/DepartmentsList.hpp>
+#include <Factory/ProductFactory.hpp>
 #include <Interfaces/IWarehouse.hpp>
+#include <Interfaces/ProductArena.hpp>
+#include <Interfaces/ProductIndex.hpp>
+#include <Warehouse/DeliveryResult.hpp>
+#include <Warehouse/DeliveryRouting.hpp>
+#include <Warehouse/JsonWriter.hpp>
+#include <Warehouse/OccupancyBoard.hpp>
+#include <Warehouse/OrderReservation.hpp>
+#include <Warehouse/ProductCatalog.hpp>
+#include <Warehouse/ThreadPool.hpp>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 
 namespace warehouse
 {
+/**
+ * @brief Describes how a warehouse may be used from many threads.
+ * @param singleThreaded The warehouse is not synchronized, its calls have to be serialized by the caller.
+ * @param shardedLocks Every call may be made concurrently. Each department has its own lock, the catalog is guarded by a
+ * reader-writer lock and the delivery routing by a mutex, so orders served by different departments proceed in parallel
+ * and deliveries lock only the departments they place into.
+ */
+enum class ThreadSafety
+{
+    singleThreaded,
+    shardedLocks
+};
+
 class Warehouse : public warehouseInterface::IWarehouse
 {
     // student code begin
+    ProductFactory productFactory_{};
+    ProductCatalog catalog_{};
+    DeliveryRouting routing_{};
+    PlacementPolicy placementPolicy_{PlacementPolicy::firstFit};
+    std::unique_ptr<ThreadPool> deliveryPool_{};
+
+    /**
+     * @brief Locks of the shardedLocks mode. They are taken in the order of the fields, and a department lock is never
+     * held while taking the routing lock.
+     * @param structure Shared by all calls, exclusive for the calls replacing or adding departments.
+     * @param departments One lock per department, in the warehouse order.
+     */
+    struct ShardedLocks
+    {
+        std::shared_mutex structure{};
+        std::mutex routing{};
+        std::deque<std::mutex> departments{};
+        std::shared_mutex catalog{};
+    };
+    std::unique_ptr<ShardedLocks> locks_{};
+    OccupancyBoard occupancyBoard_{};
+    std::uint64_t stateGeneration_{0};
+
+public:
+    Warehouse() = default;
+
+    /**
+     * @brief Creates a warehouse storing delivered products according to the placement policy instead of first-fit.
+     */
+    explicit Warehouse(PlacementPolicy placementPolicy, ThreadSafety threadSafety = ThreadSafety::singleThreaded)
+        : placementPolicy_{placementPolicy},
+          locks_{threadSafety == ThreadSafety::shardedLocks ? std::make_unique<ShardedLocks>() : nullptr}
+    {
+    }
+
+    explicit Warehouse(ThreadSafety threadSafety) : Warehouse(PlacementPolicy::firstFit, threadSafety)
+    {
+    }
+
+    ~Warehouse() override
+    {
+        const warehouseInterface::BulkRelease bulkRelease{};
+        departments_.clear();
+    }
+
+    void addDepartment(warehouseInterface::IDepartmentPtr department) override
+    {
+        if (!department)
+        {
+            return;
+        }
+        const auto structureLock = lockStructure();
+        if (locks_)
+        {
+            locks_->departments.emplace_back();
+        }
+        const auto position = departments_.size();
+        for (const auto &item : department->serializedItems())
+        {
+            catalog_.add(itemKeyOf(item), position);
+        }
+        routing_.addDepartment(*department, position);
+        occupancyBoard_.addDepartment(*department);
+        departments_.push_back(std::move(department));
+    }
+
+    /**
+     * @brief Stores the delivered products in three phases: the products are classified, then placed one by one in the
+     * delivery order, then the report entries are rendered. Only the placement changes the warehouse state, so the
+     * classification and the rendering run on the delivery threads (see setDeliveryThreads) and the result does not
+     * depend on their number.
+     * @return Delivery report JSON.
+     */
+    warehouseInterface::DeliveryReportJson newDelivery(std::vector<warehouseInterface::IProductPtr> products) override
+    {
+        const auto structureLock = shareStructure();
+        std::vector<DeliveryLine> lines(products.size());
+        forEachDeliveryLine(products.size(), [&products, &lines](std::size_t line) {
+            const auto &product = products[line];
+            if (product)
+            {
+                lines[line].result.productName = product->name();
+                lines[line].key = warehouseInterface::ProductIndex::keyOf(*product);
+            }
+        });
+
+        OccupancyBoard::Deltas deltas{};
+        for (std::size_t line = 0; line < products.size(); ++line)
+        {
+            if (products[line])
+            {
+                place(std::move(products[line]), lines[line].key, lines[line].result, deltas);
+            }
+            else
+            {
+                lines[line].result.errorLog = invalidProductError;
+            }
+        }
+        occupancyBoard_.publish(deltas);
+
+        JsonWriter report{reportEntrySize * (lines.size() + 1)};
+        report.beginObject().key("deliveryReport").beginArray();
+        if (parallelDelivery(lines.size()))
+        {
+            forEachDeliveryLine(lines.size(), [&lines](std::size_t line) {
+                JsonWriter entry{reportEntrySize};
+                lines[line].result.write(entry);
+                lines[line].entry = std::move(entry).str();
+            });
+            for (const auto &line : lines)
+            {
+                report.raw(line.entry);
+            }
+        }
+        else
+        {
+            for (const auto &line : lines)
+            {
+                line.result.write(report);
+            }
+        }
+        return std::move(report.endArray().endObject()).str();
+    }
+
+    /**
+     * @brief Streaming variant of newDelivery. Products are pulled from the input range one by one, for example from a
+     * lazy view generating them, and each one is stored before the next one is pulled. The consumer gets the result of
+     * every product as soon as it is decided, so no report is built and the results are the same as the entries of the
+     * newDelivery report for the same products.
+     * @return None.
+     */
+    template <std::ranges::input_range Products, std::invocable<const DeliveryResult &> Consumer>
+    void streamDelivery(Products &&products, Consumer &&consumer)
+    {
+        const auto structureLock = shareStructure();
+        OccupancyBoard::Deltas deltas{};
+        for (auto &&item : products)
+        {
+            warehouseInterface::IProductPtr product = std::move(item);
+            DeliveryResult result{};
+            if (product)
+            {
+                result.productName = product->name();
+                const auto key = warehouseInterface::ProductIndex::keyOf(*product);
+                deltas.clear();
+                place(std::move(product), key, result, deltas);
+                occupancyBoard_.publish(deltas);
+            }
+            else
+            {
+                result.errorLog = invalidProductError;
+            }
+            consumer(std::as_const(result));
+        }
+    }
+
+    /**
+     * @brief All-or-nothing variant of newDelivery. A tentative placement of the whole consignment is computed first,
+     * without moving any product: every product needs a department confirming it with IDepartment::canAdd and having
+     * room for it at the tentative occupancy (IDepartment::hasRoomFor). The products are stored only if all of them are
+     * placed, otherwise they stay in the vector and the report lists why every product was rejected. If a department
+     * still rejects a product, the products stored so far are taken back into the vector; the rejected product was
+     * consumed by the department and is reported as not stored.
+     * @return Delivery report JSON, in the format of newDelivery.
+     */
+    warehouseInterface::DeliveryReportJson newAtomicDelivery(std::vector<warehouseInterface::IProductPtr> &products)
+    {
+        // Other calls can only free space while the routing lock is held, so the placement stays valid until the commit.
+        const auto structureLock = shareStructure();
+        const auto routingLock = lockRouting();
+        std::vector<DeliveryResult> results(products.size());
+        std::unordered_map<std::size_t, warehouseInterface::OccupancyCounter::Units> occupancies{};
+        const auto nextSlots = routing_.nextSlots();
+        bool accepted = true;
+        for (std::size_t line = 0; line < products.size(); ++line)
+        {
+            const auto &product = products[line];
+            results[line].productName = product ? product->name() : std::string{};
+            if (!product)
+            {
+                results[line].errorLog = invalidProductError;
+                accepted = false;
+                continue;
+            }
+
+            const auto productFlags = product->itemFlags();
+            const auto productSize = product->itemSize();
+            const auto occupancyOf = [this, &occupancies](std::size_t position) {
+                const auto occupancy = occupancies.find(position);
+                return occupancy != occupancies.end() ? occupancy->second : departments_[position]->occupancyUnits();
+            };
+            const auto accepts = [this, &product, productSize, &occupancyOf](std::size_t position) {
+                const auto &department = departments_[position];
+                return department->canAdd(*product) && department->hasRoomFor(productSize, occupancyOf(position));
+            };
+            const auto productUnits = warehouseInterface::OccupancyCounter::toUnits(productSize);
+            const auto position = routing_.place(productFlags, productUnits, placementPolicy_, accepts);
+            if (position == DeliveryRouting::none)
+            {
+                const auto requiredDepartmentExists = routing_.hasRequiredDepartment(productFlags, productSize);
+                results[line].errorLog = requiredDepartmentExists ? lackOfSpaceError : lackOfDepartmentError;
+                accepted = false;
+                continue;
+            }
+            const auto occupancy = occupancyOf(position) + productUnits;
+            occupancies[position] = occupancy;
+            routing_.update(*departments_[position], position, occupancy);
+            results[line].department = position;
+        }
+
+        if (!accepted || !storeConsignment(products, results))
+        {
+            routing_.restoreNextSlots(nextSlots);
+            for (auto &result : results)
+            {
+                const auto placed = std::exchange(result.department, DeliveryResult::none) != DeliveryResult::none;
+                result.errorLog = placed ? rejectedConsignmentError : result.errorLog;
+            }
+        }
+        for (const auto &[position, occupancy] : occupancies)
+        {
+            routing_.update(*departments_[position], position);
+        }
+
+        JsonWriter report{reportEntrySize * (results.size() + 1)};
+        report.beginObject().key("deliveryReport").beginArray();
+        for (const auto &result : results)
+        {
+            result.write(report);
+        }
+        return std::move(report.endArray().endObject()).str();
+    }
+
+    /**
+     * @brief Sets the number of threads classifying delivered products and rendering delivery reports. Deliveries are
+     * processed on the calling thread only if the number is lower than 2, which is the default. It must not be called
+     * concurrently with deliveries.
+     * @return None.
+     */
+    void setDeliveryThreads(std::size_t threads)
+    {
+        deliveryPool_ = threads > 1 ? std::make_unique<ThreadPool>(threads - 1) : nullptr;
+    }
+
+    warehouseInterface::Order newOrder(const warehouseInterface::OrderJson &orderJson) override
+    {
+        const auto structureLock = shareStructure();
+        warehouseInterface::Order order{{}, orderJson};
+        OccupancyBoard::Deltas deltas{};
+        for (const auto &line : warehouseInterface::OrderQuery::compile(orderJson).lines)
+        {
+            auto product = pickItem(line, deltas);
+            if (product)
+            {
+                order.products.push_back(std::move(product));
+            }
+        }
+        occupancyBoard_.publish(deltas);
+        return order;
+    }
+
+    /**
+     * @brief Fulfils a wave of orders visiting every department once. A department state only changes when it hands out a
+     * product, and newOrder asks the departments in the warehouse order, so each department gets, in the order of the wave,
+     * the lines which no previous department could serve. The result is the same as calling newOrder for every order.
+     * @return Vector of orders, in the same order as the requested ones.
+     */
+    std::vector<warehouseInterface::Order> newOrders(std::span<const warehouseInterface::OrderJson> orders) override
+    {
+        struct Line
+        {
+            std::size_t order;
+            warehouseInterface::ProductQuery query;
+            warehouseInterface::IProductPtr product;
+        };
+
+        const auto structureLock = shareStructure();
+        std::vector<Line> lines{};
+        std::vector<std::size_t> pending{};
+        for (std::size_t order = 0; order < orders.size(); ++order)
+        {
+            for (const auto &query : warehouseInterface::OrderQuery::compile(orders[order]).lines)
+            {
+                if (query.satisfiable)
+                {
+                    pending.push_back(lines.size());
+                    lines.push_back({order, query, nullptr});
+                }
+            }
+        }
+
+        std::vector<std::size_t> unserved{};
+        OccupancyBoard::Deltas deltas{};
+        for (std::size_t position = 0; position < departments_.size() && !pending.empty(); ++position)
+        {
+            unserved.clear();
+            bool picked = false;
+            {
+                const auto departmentLock = lockDepartment(position);
+                for (const auto line : pending)
+                {
+                    const auto &query = lines[line].query;
+                    if (holds(query, position))
+                    {
+                        auto product = departments_[position]->getItem(query);
+                        if (product)
+                        {
+                            const auto catalogLock = lockCatalog();
+                            catalog_.remove(warehouseInterface::ProductIndex::keyOf(*product), position);
+                            const auto units = warehouseInterface::OccupancyCounter::toUnits(product->itemSize());
+                            deltas.emplace_back(position, -units);
+                            lines[line].product = std::move(product);
+                            picked = true;
+                            continue;
+                        }
+                    }
+                    unserved.push_back(line);
+                }
+            }
+            if (picked)
+            {
+                const auto routingLock = lockRouting();
+                routing_.update(*departments_[position], position);
+            }
+            pending.swap(unserved);
+        }
+        occupancyBoard_.publish(deltas);
+
+        std::vector<warehouseInterface::Order> result(orders.size());
+        for (std::size_t order = 0; order < orders.size(); ++order)
+        {
+            result[order].receipt = orders[order];
+        }
+        for (auto &line : lines)
+        {
+            if (line.product)
+            {
+                result[line.order].products.push_back(std::move(line.product));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief First phase of an all-or-nothing order: reserves one product for every order line, in the departments
+     * newOrder would take them from, without taking them out. Reserved products keep their space and are invisible to
+     * other orders and reservations. If any line cannot be served, the reservations made so far are released, so a
+     * failed order moves no product.
+     * @return The reservation to commit or release, nothing if the order cannot be served as a whole.
+     */
+    std::optional<OrderReservation> reserveOrder(const warehouseInterface::OrderJson &orderJson)
+    {
+        const auto structureLock = shareStructure();
+        OrderReservation reservation{orderJson, stateGeneration_};
+        for (const auto &line : warehouseInterface::OrderQuery::compile(orderJson).lines)
+        {
+            std::size_t department{};
+            auto item = takeFromHoldingDepartments(line, [this, &line, &department](std::size_t position) {
+                const auto departmentLock = lockDepartment(position);
+                department = position;
+                return departments_[position]->reserveItem(line);
+            });
+            if (!item)
+            {
+                releaseLines(std::move(reservation));
+                return std::nullopt;
+            }
+            reservation.lines.push_back({department, item});
+        }
+        return reservation;
+    }
+
+    /**
+     * @brief Second phase of an all-or-nothing order: takes all reserved products out of their departments.
+     * @return The order with all reserved products, or with none if a warehouse state was loaded since the reservation.
+     */
+    warehouseInterface::Order commitOrder(OrderReservation reservation)
+    {
+        const auto structureLock = shareStructure();
+        warehouseInterface::Order order{{}, std::move(reservation.receipt)};
+        if (reservation.generation != stateGeneration_)
+        {
+            return order;
+        }
+        OccupancyBoard::Deltas deltas{};
+        for (const auto &[position, item] : reservation.lines)
+        {
+            {
+                const auto departmentLock = lockDepartment(position);
+                auto product = departments_[position]->commitReservation(item);
+                if (!product)
+                {
+                    continue;
+                }
+                const auto catalogLock = lockCatalog();
+                catalog_.remove(warehouseInterface::ProductIndex::keyOf(*product), position);
+                deltas.emplace_back(position, -warehouseInterface::OccupancyCounter::toUnits(product->itemSize()));
+                order.products.push_back(std::move(product));
+            }
+            const auto routingLock = lockRouting();
+            routing_.update(*departments_[position], position);
+        }
+        occupancyBoard_.publish(deltas);
+        return order;
+    }
+
+    /**
+     * @brief Second phase of an all-or-nothing order: gives all reserved products back to their departments.
+     * @return None.
+     */
+    void releaseOrder(OrderReservation reservation)
+    {
+        const auto structureLock = shareStructure();
+        if (reservation.generation == stateGeneration_)
+        {
+            releaseLines(std::move(reservation));
+        }
+    }
+
+    /**
+     * @brief Fulfils the order only if every order line can be served, reserving and then committing the products.
+     * @return The order with a product for every line, or with no products.
+     */
+    warehouseInterface::Order newAtomicOrder(const warehouseInterface::OrderJson &orderJson)
+    {
+        auto reservation = reserveOrder(orderJson);
+        return reservation ? commitOrder(std::move(*reservation)) : warehouseInterface::Order{{}, orderJson};
+    }
+
+    /**
+     * @brief Renders the latest occupancy snapshot. It takes no locks, so it never blocks deliveries and orders, and it
+     * shows all departments at the same point in time.
+     * @return Occupancy report JSON.
+     */
+    warehouseInterface::OccupancyReportJson getOccupancyReport() const override
+    {
+        const auto snapshot = occupancyBoard_.snapshot();
+        JsonWriter report{reportEntrySize * (snapshot->departments + 1)};
+        report.beginObject().key("departmentsOccupancy").beginArray();
+        for (std::size_t position = 0; position < snapshot->departments; ++position)
+        {
+            const auto &department = snapshot->department(position);
+            report.beginObject()
+                    .key("departmentName")
+                    .value(department.name)
+                    .key("maxOccupancy")
+                    .value(static_cast<double>(department.maxOccupancy))
+                    .key("occupancy")
+                    .value(static_cast<double>(snapshot->occupancy(position)))
+                    .endObject();
+        }
+        return std::move(report.endArray().endObject()).str();
+    }
+
+    /**
+     * @brief Gets the latest occupancy snapshot, for readers polling the occupancy without rendering reports.
+     * @return The snapshot, which stays valid as long as the pointer is held.
+     */
+    std::shared_ptr<const OccupancySnapshot> occupancySnapshot() const
+    {
+        return occupancyBoard_.snapshot();
+    }
+
+    warehouseInterface::WarehouseStateJson saveWarehouseState() const override
+    {
+        const auto structureLock = shareStructure();
+        picojson::array departments{};
+        for (std::size_t position = 0; position < departments_.size(); ++position)
+        {
+            const auto departmentLock = lockDepartment(position);
+            departments.emplace_back(departments_[position]->asJson());
+        }
+
+        picojson::object result{};
+        result["warehouseState"] = picojson::value(std::move(departments));
+        return picojson::value(std::move(result)).serialize();
+    }
+
+    bool loadWarehouseState(const warehouseInterface::WarehouseStateJson &state) override
+    {
+        picojson::value json;
+        if (!picojson::parse(json, state).empty() || !json.is<picojson::object>())
+        {
+            return false;
+        }
+        const auto &object = json.get<picojson::object>();
+        const auto savedDepartments = object.find("warehouseState");
+        if (savedDepartments == object.end() || !savedDepartments->second.is<picojson::array>())
+        {
+            return false;
+        }
+
+        std::vector<warehouseInterface::IDepartmentPtr> departments{};
+        ProductCatalog catalog{};
+        for (const auto &savedDepartment : savedDepartments->second.get<picojson::array>())
+        {
+            if (!hasFields(savedDepartment, {{"class", stringType}, {"maxOccupancy", numberType}, {"items", arrayType}}))
+            {
+                return false;
+            }
+            auto department = createDepartment(savedDepartment.get("class").get<std::string>(),
+                                               static_cast<float>(savedDepartment.get("maxOccupancy").get<double>()));
+            if (!department)
+            {
+                return false;
+            }
+
+            for (const auto &item : savedDepartment.get("items").get<picojson::array>())
+            {
+                if (!hasFields(item, {{"class", stringType}, {"name", stringType}, {"size", numberType}}))
+                {
+                    return false;
+                }
+                try
+                {
+                    auto product = productFactory_.createProduct(item.get("class").get<std::string>(),
+                                                                 item.get("name").get<std::string>(),
+                                                                 static_cast<float>(item.get("size").get<double>()));
+                    const auto key = warehouseInterface::ProductIndex::keyOf(*product);
+                    if (!department->addItem(std::move(product)))
+                    {
+                        return false;
+                    }
+                    catalog.add(key, departments.size());
+                }
+                catch (const std::runtime_error &)
+                {
+                    return false;
+                }
+            }
+            departments.push_back(std::move(department));
+        }
+
+        // The replaced departments give their products back to the product arena in one go.
+        const warehouseInterface::BulkRelease bulkRelease{};
+        const auto structureLock = lockStructure();
+        if (locks_)
+        {
+            locks_->departments = std::deque<std::mutex>(departments.size());
+        }
+        departments_ = std::move(departments);
+        catalog_ = std::move(catalog);
+        ++stateGeneration_;
+        occupancyBoard_.reset(departments_);
+        routing_.clear();
+        for (std::size_t position = 0; position < departments_.size(); ++position)
+        {
+            routing_.addDepartment(*departments_[position], position);
+        }
+        return true;
+    }
+
+private:
+    static constexpr auto lackOfSpaceError = "Warehouse cannot store this product. Lack of space in departments.";
+    static constexpr auto lackOfDepartmentError = "Warehouse cannot store this product. Lack of required department.";
+    static constexpr auto invalidProductError = "Warehouse cannot store this product. Invalid product.";
+    static constexpr auto rejectedConsignmentError = "Warehouse cannot store this product. Consignment rejected.";
+
+    /**
+     * @brief Deliveries smaller than this are processed on the calling thread even if delivery threads are set.
+     */
+    static constexpr std::size_t parallelDeliveryThreshold = 1024;
+
+    /**
+     * @brief Typical size of a report entry, used to reserve report buffers.
+     */
+    static constexpr std::size_t reportEntrySize = 160;
+
+    /**
+     * @brief A delivered product on its way through newDelivery.
+     * @param key Catalog key of the product.
+     * @param entry The rendered report entry.
+     */
+    struct DeliveryLine
+    {
+        DeliveryResult result{};
+        warehouseInterface::ProductKey key{};
+        std::string entry{};
+    };
+
+    enum FieldType
+    {
+        stringType,
+        numberType,
+        arrayType
+    };
+
+    /**
+     * @brief Checks if the JSON object contains all required fields of the proper types.
+     * @return true if all fields exist, false otherwise.
+     */
+    static bool hasFields(const picojson::value &json, std::initializer_list<std::pair<const char *, FieldType>> fields)
+    {
+        if (!json.is<picojson::object>())
+        {
+            return false;
+        }
+        for (const auto &[field, type] : fields)
+        {
+            if (!json.contains(field))
+            {
+                return false;
+            }
+            const auto &value = json.get(field);
+            if ((type == stringType && !value.is<std::string>()) || (type == numberType && !value.is<double>()) ||
+                (type == arrayType && !value.is<picojson::array>()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parallelDelivery(std::size_t count) const
+    {
+        return deliveryPool_ && count >= parallelDeliveryThreshold;
+    }
+
+    std::shared_lock<std::shared_mutex> shareStructure() const
+    {
+        return locks_ ? std::shared_lock{locks_->structure} : std::shared_lock<std::shared_mutex>{};
+    }
+
+    std::unique_lock<std::shared_mutex> lockStructure()
+    {
+        return locks_ ? std::unique_lock{locks_->structure} : std::unique_lock<std::shared_mutex>{};
+    }
+
+    std::unique_lock<std::mutex> lockRouting()
+    {
+        return locks_ ? std::unique_lock{locks_->routing} : std::unique_lock<std::mutex>{};
+    }
+
+    std::unique_lock<std::mutex> lockDepartment(std::size_t position) const
+    {
+        return locks_ ? std::unique_lock{locks_->departments[position]} : std::unique_lock<std::mutex>{};
+    }
+
+    std::shared_lock<std::shared_mutex> shareCatalog() const
+    {
+        return locks_ ? std::shared_lock{locks_->catalog} : std::shared_lock<std::shared_mutex>{};
+    }
+
+    std::unique_lock<std::shared_mutex> lockCatalog()
+    {
+        return locks_ ? std::unique_lock{locks_->catalog} : std::unique_lock<std::shared_mutex>{};
+    }
+
+    bool holds(const warehouseInterface::ProductQuery &query, std::size_t position) const
+    {
+        const auto catalogLock = shareCatalog();
+        return catalog_.holds(query.productClass, query.name, position);
+    }
+
+    template <typename Body>
+    void forEachDeliveryLine(std::size_t count, const Body &body)
+    {
+        if (parallelDelivery(count))
+        {
+            deliveryPool_->parallelFor(count, body);
+            return;
+        }
+        for (std::size_t line = 0; line < count; ++line)
+        {
+            body(line);
+        }
+    }
+
+    /**
+     * @brief Stores the product in the department chosen by the placement policy and records the outcome and the
+     * occupancy change. The candidate departments which IDepartment::canAdd does not confirm are skipped, so the product
+     * is handed over only to a department which accepts it.
+     * @return None.
+     */
+    void place(warehouseInterface::IProductPtr product, const warehouseInterface::ProductKey &key, DeliveryResult &result,
+               OccupancyBoard::Deltas &deltas)
+    {
+        // Occupancies are read without department locks. Only deliveries add products and they hold the routing lock, so
+        // a department with room keeps it until the product is stored.
+        const auto routingLock = lockRouting();
+        const auto productFlags = product->itemFlags();
+        const auto productSize = product->itemSize();
+        const auto productUnits = warehouseInterface::OccupancyCounter::toUnits(productSize);
+        const auto accepts = [this, &product](std::size_t position) { return departments_[position]->canAdd(*product); };
+        const auto position = routing_.place(productFlags, productUnits, placementPolicy_, accepts);
+
+        if (position != DeliveryRouting::none)
+        {
+            auto &department = departments_[position];
+            bool stored = false;
+            {
+                const auto departmentLock = lockDepartment(position);
+                stored = department->addItem(std::move(product));
+                if (stored)
+                {
+                    const auto catalogLock = lockCatalog();
+                    catalog_.add(key, position);
+                    deltas.emplace_back(position, warehouseInterface::OccupancyCounter::toUnits(productSize));
+                }
+            }
+            routing_.update(*department, position);
+            if (stored)
+            {
+                result.department = position;
+                result.assignedDepartment = department->departmentName();
+                return;
+            }
+        }
+        const auto requiredDepartmentExists = routing_.hasRequiredDepartment(productFlags, productSize);
+        result.errorLog = requiredDepartmentExists ? lackOfSpaceError : lackOfDepartmentError;
+    }
+
+    /**
+     * @brief Stores the products of an atomic delivery in the departments of their results. If a department rejects a
+     * product, the products stored before it are taken back into the vector in the reverse order and the result of the
+     * rejected product gets the lack of space error.
+     * @return true if all products were stored and moved out of the vector, false if none was.
+     */
+    bool storeConsignment(std::vector<warehouseInterface::IProductPtr> &products, std::vector<DeliveryResult> &results)
+    {
+        OccupancyBoard::Deltas deltas{};
+        std::vector<warehouseInterface::ProductKey> keys(products.size());
+        std::size_t line = 0;
+        for (; line < products.size(); ++line)
+        {
+            auto &result = results[line];
+            auto &department = departments_[result.department];
+            keys[line] = warehouseInterface::ProductIndex::keyOf(*products[line]);
+            const auto units = warehouseInterface::OccupancyCounter::toUnits(products[line]->itemSize());
+            const auto departmentLock = lockDepartment(result.department);
+            if (!department->addItem(std::move(products[line])))
+            {
+                result.errorLog = lackOfSpaceError;
+                result.department = DeliveryResult::none;
+                break;
+            }
+            const auto catalogLock = lockCatalog();
+            catalog_.add(keys[line], result.department);
+            deltas.emplace_back(result.department, units);
+        }
+
+        if (line == products.size())
+        {
+            for (auto &result : results)
+            {
+                result.assignedDepartment = departments_[result.department]->departmentName();
+            }
+            products.clear();
+            occupancyBoard_.publish(deltas);
+            return true;
+        }
+        while (line-- > 0)
+        {
+            const auto position = results[line].department;
+            const auto departmentLock = lockDepartment(position);
+            products[line] = departments_[position]->takeBackItem(keys[line]);
+            const auto catalogLock = lockCatalog();
+            catalog_.remove(keys[line], position);
+        }
+        return false;
+    }
+
+    static std::string stringField(const picojson::value &json, const char *field)
+    {
+        return json.contains(field) && json.get(field).is<std::string>() ? json.get(field).get<std::string>() : std::string{};
+    }
+
+    /**
+     * @brief Builds the catalog key of a stored product from its JSON object.
+     * @return The product key.
+     */
+    static warehouseInterface::ProductKey itemKeyOf(const picojson::value &json)
+    {
+        return {warehouseInterface::ProductClassTable::instance().intern(stringField(json, "class")),
+                warehouseInterface::NamePool::instance().intern(stringField(json, "name"))};
+    }
+
+    /**
+     * @brief Takes the requested product from the first department which holds it and hands it out, recording the
+     * occupancy change.
+     * @return A valid pointer if a matching product was found, nullptr otherwise.
+     */
+    warehouseInterface::IProductPtr pickItem(const warehouseInterface::ProductQuery &query, OccupancyBoard::Deltas &deltas)
+    {
+        const auto pickFrom = [this, &query, &deltas](std::size_t position) {
+            warehouseInterface::IProductPtr product{};
+            {
+                const auto departmentLock = lockDepartment(position);
+                product = departments_[position]->getItem(query);
+                if (!product)
+                {
+                    return product;
+                }
+                const auto catalogLock = lockCatalog();
+                catalog_.remove(warehouseInterface::ProductIndex::keyOf(*product), position);
+                deltas.emplace_back(position, -warehouseInterface::OccupancyCounter::toUnits(product->itemSize()));
+            }
+            const auto routingLock = lockRouting();
+            routing_.update(*departments_[position], position);
+            return product;
+        };
+        return takeFromHoldingDepartments(query, pickFrom);
+    }
+
+    /**
+     * @brief Calls take for the departments holding products matching the query, in the warehouse order, until it
+     * succeeds. take may remove the product it finds from the catalog.
+     * @return The first successful result of take, an empty result if there is none.
+     */
+    template <typename Take>
+    auto takeFromHoldingDepartments(const warehouseInterface::ProductQuery &query, const Take &take)
+            -> decltype(take(std::size_t{}))
+    {
+        if (!query.satisfiable)
+        {
+            return {};
+        }
+        if (!locks_)
+        {
+            if (const auto *stock = catalog_.departmentsHolding(query.productClass, query.name))
+            {
+                for (const auto &holding : *stock)
+                {
+                    // Removing the product from the catalog may erase the stock entry, so the position is copied.
+                    const auto position = holding.first;
+                    if (auto result = take(position))
+                    {
+                        return result;
+                    }
+                }
+            }
+            return {};
+        }
+
+        // Other threads change the catalog while the departments are visited, so the holding departments are copied.
+        std::vector<std::size_t> positions{};
+        {
+            const auto catalogLock = shareCatalog();
+            if (const auto *stock = catalog_.departmentsHolding(query.productClass, query.name))
+            {
+                for (const auto &holding : *stock)
+                {
+                    positions.push_back(holding.first);
+                }
+            }
+        }
+        for (const auto position : positions)
+        {
+            if (auto result = take(position))
+            {
+                return result;
+            }
+        }
+        return {};
+    }
+
+    void releaseLines(OrderReservation reservation)
+    {
+        for (const auto &[position, item] : reservation.lines)
+        {
+            const auto departmentLock = lockDepartment(position);
+            departments_[position]->releaseReservation(item);
+        }
+    }
+
+    static warehouseInterface::IDepartmentPtr createDepartment(const std::string &className, float maxOccupancy)
+    {
+        if (className == "ColdRoomDepartment")
+        {
+            return std::make_unique<ColdRoomDepartment>(maxOccupancy);
+        }
+        if (className == "SmallElectronicDepartment")
+        {
+            return std::make_unique<SmallElectronicDepartment>(maxOccupancy);
+        }
+        if (className == "OverSizeElectronicDepartment")
+        {
+            return std::make_unique<OverSizeElectronicDepartment>(maxOccupancy);
+        }
+        if (className == "HazardousDepartment")
+        {
+            return std::make_unique<HazardousDepartment>(maxOccupancy);
+        }
+        if (className == "SpecialDepartment")
+        {
+            return std::make_unique<SpecialDepartment>(maxOccupancy);
+        }
+        return nullptr;
+    }
     // student code end
 };
 
-}  // namespace warehouse
\ No newline at end of file
+}  // namespace warehouse
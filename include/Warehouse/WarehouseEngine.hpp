@@ -0,0 +1,170 @@
+#pragma once
+#include <Warehouse/MpscRing.hpp>
+#include <Warehouse/Warehouse.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace warehouse
+{
+/**
+ * @brief Single-writer front end of a warehouse. Commands from any number of threads are queued in a lock-free ring and
+ * applied in queue order by one engine thread, which owns the warehouse, so the warehouse runs single-threaded and takes
+ * no locks. Every command returns a future completed by the engine. The engine drains all queued commands before it
+ * goes to sleep, and producers wake it only when it sleeps.
+ */
+class WarehouseEngine
+{
+    using Command = std::packaged_task<void()>;
+
+    static constexpr std::size_t defaultCapacity = 4096;
+
+    Warehouse warehouse_;
+    MpscRing<Command> commands_;
+    std::atomic<bool> sleeping_{false};
+    std::atomic<std::uint32_t> wakeups_{0};
+    bool running_{true};
+    std::jthread engine_{};
+
+public:
+    /**
+     * @param capacity Number of commands the queue holds before producers wait.
+     */
+    explicit WarehouseEngine(PlacementPolicy placementPolicy = PlacementPolicy::firstFit,
+                             std::size_t capacity = defaultCapacity)
+        : warehouse_{placementPolicy}, commands_{capacity}
+    {
+        engine_ = std::jthread{[this] { run(); }};
+    }
+
+    WarehouseEngine(const WarehouseEngine &) = delete;
+    WarehouseEngine &operator=(const WarehouseEngine &) = delete;
+
+    /**
+     * @brief Applies all queued commands and stops the engine.
+     */
+    ~WarehouseEngine()
+    {
+        submit([this](Warehouse &) { running_ = false; });
+    }
+
+    /**
+     * @brief Queues a command, called on the engine thread with the warehouse.
+     * @return Future of the command result.
+     */
+    template <typename Function>
+    std::future<std::invoke_result_t<Function &, Warehouse &>> submit(Function &&function)
+    {
+        std::packaged_task<std::invoke_result_t<Function &, Warehouse &>()> task{
+                [this, function = std::forward<Function>(function)]() mutable { return function(warehouse_); }};
+        auto result = task.get_future();
+        commands_.push(Command{std::move(task)});
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed))
+        {
+            wakeups_.fetch_add(1, std::memory_order_release);
+            wakeups_.notify_one();
+        }
+        return result;
+    }
+
+    std::future<void> addDepartment(warehouseInterface::IDepartmentPtr department)
+    {
+        return submit([department = std::move(department)](Warehouse &warehouse) mutable {
+            warehouse.addDepartment(std::move(department));
+        });
+    }
+
+    std::future<warehouseInterface::DeliveryReportJson> newDelivery(std::vector<warehouseInterface::IProductPtr> products)
+    {
+        return submit([products = std::move(products)](Warehouse &warehouse) mutable {
+            return warehouse.newDelivery(std::move(products));
+        });
+    }
+
+    std::future<warehouseInterface::Order> newOrder(warehouseInterface::OrderJson order)
+    {
+        return submit([order = std::move(order)](Warehouse &warehouse) { return warehouse.newOrder(order); });
+    }
+
+    std::future<warehouseInterface::OccupancyReportJson> getOccupancyReport()
+    {
+        return submit([](Warehouse &warehouse) { return warehouse.getOccupancyReport(); });
+    }
+
+    std::future<warehouseInterface::WarehouseStateJson> saveWarehouseState()
+    {
+        return submit([](Warehouse &warehouse) { return warehouse.saveWarehouseState(); });
+    }
+
+    std::future<bool> loadWarehouseState(warehouseInterface::WarehouseStateJson state)
+    {
+        return submit([state = std::move(state)](Warehouse &warehouse) { return warehouse.loadWarehouseState(state); });
+    }
+
+    /**
+     * @brief Gets the latest occupancy snapshot without queueing a command.
+     * @return The snapshot, which stays valid as long as the pointer is held.
+     */
+    std::shared_ptr<const OccupancySnapshot> occupancySnapshot() const
+    {
+        return warehouse_.occupancySnapshot();
+    }
+
+    /**
+     * @brief Pins the engine thread to one CPU. Supported on Linux only.
+     * @return Future telling whether the thread was pinned.
+     */
+    std::future<bool> pinToCpu(unsigned cpu)
+    {
+        return submit([cpu](Warehouse &) {
+#if defined(__linux__)
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+            static_cast<void>(cpu);
+            return false;
+#endif
+        });
+    }
+
+private:
+    void run()
+    {
+        while (running_)
+        {
+            if (auto command = commands_.tryPop())
+            {
+                (*command)();
+                continue;
+            }
+
+            const auto wakeups = wakeups_.load(std::memory_order_acquire);
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (auto command = commands_.tryPop())
+            {
+                sleeping_.store(false, std::memory_order_relaxed);
+                (*command)();
+                continue;
+            }
+            wakeups_.wait(wakeups, std::memory_order_acquire);
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+};
+
+}  // namespace warehouse
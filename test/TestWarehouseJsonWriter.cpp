@@ -0,0 +1,80 @@
+#include <PicoJson/picojson.h>
+#include <Warehouse/JsonWriter.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace warehouse
+{
+TEST(JsonWriterTest, StringsMatchPicojson)
+{
+    const std::vector<std::string> texts{"",
+                                         "Glass Plate",
+                                         "quote \" backslash \\ slash /",
+                                         "\b\f\n\r\t",
+                                         std::string{"\x01\x1f\x7f", 3} + std::string(1, '\0'),
+                                         "zażółć \xe2\x82\xac"};
+    for (const auto &text : texts)
+    {
+        JsonWriter writer{};
+        writer.value(text);
+        EXPECT_EQ(writer.str(), picojson::value(text).serialize());
+    }
+}
+
+TEST(JsonWriterTest, NumbersMatchPicojson)
+{
+    for (const double number : {0.0, -0.0, 1.0, 10.0, -3.0, 0.5, 0.1, 1.0 / 3.0, 2.5e-7, 1e21, 9007199254740992.0,
+                                static_cast<double>(0.1f), static_cast<double>(3.4e38f)})
+    {
+        JsonWriter writer{};
+        writer.value(number);
+        EXPECT_EQ(writer.str(), picojson::value(number).serialize());
+    }
+}
+
+TEST(JsonWriterTest, NestedDocumentsMatchPicojson)
+{
+    picojson::object inner{};
+    inner["a"] = picojson::value(1.0);
+    inner["b"] = picojson::value("x");
+    picojson::array array{};
+    array.emplace_back(inner);
+    array.emplace_back(picojson::array{});
+    array.emplace_back(picojson::object{});
+    array.emplace_back(inner);
+    picojson::object outer{};
+    outer["list"] = picojson::value(array);
+    outer["name"] = picojson::value("warehouse");
+
+    JsonWriter writer{64};
+    writer.beginObject().key("list").beginArray();
+    writer.beginObject().key("a").value(1.0).key("b").value("x").endObject();
+    writer.beginArray().endArray();
+    writer.beginObject().endObject();
+    writer.raw(picojson::value(inner).serialize());
+    writer.endArray().key("name").value("warehouse").endObject();
+    EXPECT_EQ(writer.str(), picojson::value(outer).serialize());
+}
+
+TEST(JsonWriterTest, DeepNestingMatchesPicojson)
+{
+    picojson::value expected{picojson::array{picojson::value(1.0), picojson::value(2.0)}};
+    JsonWriter writer{};
+    constexpr int depth = 150;
+    for (int level = 0; level < depth; ++level)
+    {
+        writer.beginArray().value(1.0);
+    }
+    writer.value(2.0);
+    for (int level = 1; level < depth; ++level)
+    {
+        writer.endArray().value(2.0);
+        expected = picojson::value(picojson::array{picojson::value(1.0), expected, picojson::value(2.0)});
+    }
+    writer.endArray();
+    EXPECT_EQ(writer.str(), expected.serialize());
+}
+
+}  // namespace warehouse
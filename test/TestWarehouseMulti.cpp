@@ -1,12 +1,18 @@
 
 #include <PicoJson/picojson.h>
+#include <Warehouse/OrderGateway.hpp>
 #include <Warehouse/Warehouse.h>
+#include <Warehouse/WarehouseEngine.hpp>
 #include <gtest/gtest.h>
 
 #include <Departments/DepartmentsList.hpp>
 #include <Factory/ProductFactory.hpp>
 #include <Products/ProductsList.hpp>
+#include <atomic>
+#include <coroutine>
+#include <future>
 #include <iostream>
+#include <thread>
 
 namespace warehouse
 {
@@ -187,4 +193,750 @@ TEST(WarehouseTest, ProductAll)
     }
 }
 
-}  // namespace warehouse
\ No newline at end of file
+TEST(WarehouseTest, OrdersFollowStockAcrossDepartments)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+
+    warehouse.addDepartment(std::make_unique<ColdRoomDepartment>(4.0));
+    warehouse.addDepartment(std::make_unique<ColdRoomDepartment>(4.0));
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    std::vector<warehouseInterface::IProduct *> productsRawPtrs{};
+    for (const auto *name : {"Vanilla", "Chocolate", "Vanilla", "Chocolate"})
+    {
+        products.emplace_back(productFactory.createProduct("AstronautsIceCream", name, 2.0f));
+        productsRawPtrs.emplace_back(products.back().get());
+    }
+    warehouse.newDelivery(std::move(products));
+
+    {
+        auto order = warehouse.newOrder("{\"order\": [{\"name\":\"Vanilla\"},{\"name\":\"Vanilla\"},{\"name\":\"Vanilla\"}]}");
+        ASSERT_EQ(order.products.size(), 2);
+        EXPECT_EQ(order.products[0].get(), productsRawPtrs[0]);
+        EXPECT_EQ(order.products[1].get(), productsRawPtrs[2]);
+    }
+    {
+        auto order = warehouse.newOrder("{\"order\": [{\"class\":\"AstronautsIceCream\"},{}]}");
+        ASSERT_EQ(order.products.size(), 2);
+        EXPECT_EQ(order.products[0].get(), productsRawPtrs[1]);
+        EXPECT_EQ(order.products[1].get(), productsRawPtrs[3]);
+    }
+    EXPECT_EQ(warehouse.getOccupancyReport(),
+              "{\"departmentsOccupancy\":[{\"departmentName\":\"ColdRoomDepartment\",\"maxOccupancy\":4,\"occupancy\":0},{"
+              "\"departmentName\":\"ColdRoomDepartment\",\"maxOccupancy\":4,\"occupancy\":0}]}");
+}
+
+TEST(WarehouseTest, OrdersWaveMatchesSequentialOrders)
+{
+    const auto stockWarehouse = [](Warehouse &warehouse) {
+        ProductFactory productFactory{};
+        warehouse.addDepartment(std::make_unique<SpecialDepartment>(100.0));
+        warehouse.addDepartment(std::make_unique<ColdRoomDepartment>(6.0));
+        warehouse.addDepartment(std::make_unique<ColdRoomDepartment>(6.0));
+        warehouse.addDepartment(std::make_unique<HazardousDepartment>(1000.0));
+
+        std::vector<warehouseInterface::IProductPtr> products{};
+        for (const auto *name : {"Vanilla", "Chocolate", "Vanilla", "Apple", "Chocolate", "Vanilla"})
+        {
+            products.emplace_back(productFactory.createProduct("AstronautsIceCream", name, 2.0f));
+        }
+        products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 0.5f));
+        products.emplace_back(productFactory.createProduct("TV", "Brave", 40.0f));
+        products.emplace_back(productFactory.createProduct("AcetoneBarrel", "1 gal", 50.0f));
+        products.emplace_back(productFactory.createProduct("ExplosiveBarrel", "100l", 100.0f));
+        warehouse.newDelivery(std::move(products));
+    };
+
+    const std::vector<warehouseInterface::OrderJson> orders{
+            "{\"order\": [{\"name\":\"Vanilla\"},{\"class\":\"AstronautsIceCream\"},{\"name\":\"Vanilla\"}]}",
+            "{\"order\": [{\"class\":\"GlassWare\"},{\"class\":\"ExplosiveBarrel\"},{\"class\":\"TV\"}]}",
+            "{\"order\": [{\"name\":\"Chocolate\"},{\"class\":\"AstronautsIceCream\",\"name\":\"Vanilla\"}]}",
+            "{'order':[]}",
+            "{\"order\": [{\"class\":\"AcetoneBarrel\"},{\"class\":\"ExplosiveBarrel\"},{\"class\":\"GlassWare\"}]}",
+            "{\"order\": [{\"class\":\"AstronautsIceCream\"},{\"class\":\"AstronautsIceCream\"},{}]}"};
+
+    Warehouse sequentialWarehouse{};
+    stockWarehouse(sequentialWarehouse);
+    std::vector<warehouseInterface::Order> sequentialOrders{};
+    for (const auto &order : orders)
+    {
+        sequentialOrders.push_back(sequentialWarehouse.newOrder(order));
+    }
+
+    Warehouse batchWarehouse{};
+    stockWarehouse(batchWarehouse);
+    auto batchOrders = batchWarehouse.newOrders(orders);
+
+    ASSERT_EQ(batchOrders.size(), sequentialOrders.size());
+    for (std::size_t i = 0; i < orders.size(); ++i)
+    {
+        EXPECT_EQ(batchOrders[i].receipt, sequentialOrders[i].receipt);
+        ASSERT_EQ(batchOrders[i].products.size(), sequentialOrders[i].products.size());
+        for (std::size_t j = 0; j < batchOrders[i].products.size(); ++j)
+        {
+            EXPECT_EQ(batchOrders[i].products[j]->serialize(), sequentialOrders[i].products[j]->serialize());
+        }
+    }
+    EXPECT_EQ(batchWarehouse.saveWarehouseState(), sequentialWarehouse.saveWarehouseState());
+}
+
+TEST(DeliveryRoutingTest, CandidatesFollowRequiredDepartment)
+{
+    using warehouseInterface::ProductLabelFlags;
+    DeliveryRouting routing{};
+    routing.addDepartment(ColdRoomDepartment{1.0}, 0);
+    routing.addDepartment(SmallElectronicDepartment{1.0}, 1);
+    routing.addDepartment(HazardousDepartment{1.0}, 2);
+    routing.addDepartment(SpecialDepartment{1.0}, 3);
+
+    EXPECT_EQ(routing.candidates(AstronautsIceCream{"Ice Cream", 1.0f}.itemFlags()), (std::vector<std::size_t>{0}));
+    EXPECT_EQ(routing.candidates(ElectronicParts{"Transistor", 1.0f}.itemFlags()), (std::vector<std::size_t>{1}));
+    EXPECT_EQ(routing.candidates(AcetoneBarrel{"Acetone", 1.0f}.itemFlags()), (std::vector<std::size_t>{2}));
+    EXPECT_EQ(routing.candidates(GlassWare{"Glass Plate", 1.0f}.itemFlags()), (std::vector<std::size_t>{3}));
+    EXPECT_EQ(routing.candidates(ProductLabelFlags{}), (std::vector<std::size_t>{0, 1, 2, 3}));
+
+    routing.clear();
+    EXPECT_TRUE(routing.candidates(ProductLabelFlags{}).empty());
+}
+
+TEST(CapacityTreeTest, FindsFirstSlotWithRoom)
+{
+    const auto units = [](float size) { return warehouseInterface::OccupancyCounter::toUnits(size); };
+    CapacityTree tree{};
+    EXPECT_EQ(tree.findFirst(units(0.0f)), 0u);
+    for (const auto capacity : {1.0f, 0.0f, 5.0f, 2.0f, 5.0f})
+    {
+        tree.push_back(units(capacity));
+    }
+    EXPECT_EQ(tree.findFirst(units(0.5f)), 0u);
+    EXPECT_EQ(tree.findFirst(units(3.0f)), 2u);
+    EXPECT_EQ(tree.findFirst(units(3.0f), 3), 4u);
+    EXPECT_EQ(tree.findFirst(units(6.0f)), tree.size());
+
+    tree.update(2, units(0.0f));
+    EXPECT_EQ(tree.findFirst(units(3.0f)), 4u);
+    tree.update(1, units(7.0f));
+    EXPECT_EQ(tree.findFirst(units(6.0f)), 1u);
+}
+
+TEST(WarehouseTest, DeliveriesSkipFullDepartments)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    for (int bay = 0; bay < 100; ++bay)
+    {
+        warehouse.addDepartment(std::make_unique<SpecialDepartment>(1.0));
+    }
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    for (int item = 0; item < 150; ++item)
+    {
+        products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 0.75f));
+    }
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Cup", 0.25f));
+    warehouse.newDelivery(std::move(products));
+
+    picojson::value report;
+    picojson::parse(report, warehouse.getOccupancyReport());
+    const auto &departments = report.get("departmentsOccupancy").get<picojson::array>();
+    EXPECT_DOUBLE_EQ(departments.front().get("occupancy").get<double>(), 1.0);
+    EXPECT_DOUBLE_EQ(departments[1].get("occupancy").get<double>(), 0.75);
+    EXPECT_DOUBLE_EQ(departments.back().get("occupancy").get<double>(), 0.75);
+
+    auto order = warehouse.newOrder("{\"order\":[{\"name\":\"Glass Cup\"}]}");
+    ASSERT_EQ(order.products.size(), 1u);
+}
+
+TEST(WarehouseTest, PlacementPolicies)
+{
+    const auto occupancies = [](PlacementPolicy policy) {
+        ProductFactory productFactory{};
+        Warehouse warehouse{policy};
+        for (const auto maxOccupancy : {4.0f, 2.0f, 3.0f})
+        {
+            warehouse.addDepartment(std::make_unique<SpecialDepartment>(maxOccupancy));
+        }
+        std::vector<warehouseInterface::IProductPtr> products{};
+        for (const auto size : {1.5f, 1.5f, 1.5f, 0.5f})
+        {
+            products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", size));
+        }
+        warehouse.newDelivery(std::move(products));
+
+        picojson::value report;
+        picojson::parse(report, warehouse.getOccupancyReport());
+        std::vector<double> result{};
+        for (const auto &department : report.get("departmentsOccupancy").get<picojson::array>())
+        {
+            result.push_back(department.get("occupancy").get<double>());
+        }
+        return result;
+    };
+
+    EXPECT_EQ(occupancies(PlacementPolicy::firstFit), (std::vector<double>{3.5, 1.5, 0.0}));
+    EXPECT_EQ(occupancies(PlacementPolicy::bestFit), (std::vector<double>{0.0, 2.0, 3.0}));
+    EXPECT_EQ(occupancies(PlacementPolicy::worstFit), (std::vector<double>{3.0, 0.5, 1.5}));
+    EXPECT_EQ(occupancies(PlacementPolicy::nextFit), (std::vector<double>{3.0, 2.0, 0.0}));
+}
+
+TEST(WarehouseTest, PlacementCountsSizesInMicroUnits)
+{
+    for (const auto policy :
+         {PlacementPolicy::firstFit, PlacementPolicy::bestFit, PlacementPolicy::worstFit, PlacementPolicy::nextFit})
+    {
+        ProductFactory productFactory{};
+        Warehouse warehouse{policy};
+        for (int bay = 0; bay < 3; ++bay)
+        {
+            warehouse.addDepartment(std::make_unique<SpecialDepartment>(1.0f));
+        }
+        std::vector<warehouseInterface::IProductPtr> products{};
+        for (int item = 0; item < 31; ++item)
+        {
+            products.emplace_back(productFactory.createProduct("GlassWare", "Glass Chip", 0.1f));
+        }
+        picojson::value delivery;
+        picojson::parse(delivery, warehouse.newDelivery(std::move(products)));
+        const auto &results = delivery.get("deliveryReport").get<picojson::array>();
+        EXPECT_EQ(results.back().get("errorLog").get<std::string>(),
+                  "Warehouse cannot store this product. Lack of space in departments.");
+
+        picojson::value report;
+        picojson::parse(report, warehouse.getOccupancyReport());
+        for (const auto &department : report.get("departmentsOccupancy").get<picojson::array>())
+        {
+            EXPECT_DOUBLE_EQ(department.get("occupancy").get<double>(), 1.0);
+        }
+    }
+}
+
+TEST(WarehouseTest, ParallelDeliveryMatchesSequentialDelivery)
+{
+    const auto deliver = [](std::size_t threads) {
+        ProductFactory productFactory{};
+        Warehouse warehouse{};
+        warehouse.setDeliveryThreads(threads);
+        warehouse.addDepartment(std::make_unique<ColdRoomDepartment>(500.0));
+        warehouse.addDepartment(std::make_unique<SmallElectronicDepartment>(400.0));
+        warehouse.addDepartment(std::make_unique<HazardousDepartment>(300.0));
+        warehouse.addDepartment(std::make_unique<SpecialDepartment>(600.0));
+
+        const char *classes[] = {"AcetoneBarrel", "AstronautsIceCream", "ElectronicParts", "ExplosiveBarrel",
+                                 "GlassWare",     "IndustrialServerRack", "TV"};
+        std::vector<warehouseInterface::IProductPtr> products{};
+        for (int item = 0; item < 5000; ++item)
+        {
+            if (item % 97 == 0)
+            {
+                products.emplace_back(nullptr);
+                continue;
+            }
+            const auto size = 0.25f * static_cast<float>(item % 13 + 1);
+            const auto name = "Item " + std::to_string(item % 50);
+            products.emplace_back(productFactory.createProduct(classes[item % 7], name, size));
+        }
+        auto report = warehouse.newDelivery(std::move(products));
+        return std::make_pair(std::move(report), warehouse.saveWarehouseState());
+    };
+
+    const auto sequential = deliver(1);
+    const auto parallel = deliver(4);
+    EXPECT_EQ(parallel.first, sequential.first);
+    EXPECT_EQ(parallel.second, sequential.second);
+    EXPECT_NE(sequential.first.find("Lack of space"), std::string::npos);
+}
+
+TEST(WarehouseTest, StreamingDeliveryMatchesReport)
+{
+    const auto addDepartments = [](Warehouse &warehouse) {
+        warehouse.addDepartment(std::make_unique<SmallElectronicDepartment>(2.0));
+        warehouse.addDepartment(std::make_unique<SpecialDepartment>(3.0));
+    };
+    ProductFactory productFactory{};
+    const auto createProduct = [&productFactory](int item) -> warehouseInterface::IProductPtr {
+        const char *classes[] = {"ElectronicParts", "GlassWare", "AcetoneBarrel", "TV"};
+        return item == 3 ? nullptr : productFactory.createProduct(classes[item % 4], "Item " + std::to_string(item), 1.0f);
+    };
+
+    Warehouse reported{};
+    addDepartments(reported);
+    std::vector<warehouseInterface::IProductPtr> products{};
+    for (int item = 0; item < 8; ++item)
+    {
+        products.push_back(createProduct(item));
+    }
+    const auto report = reported.newDelivery(std::move(products));
+
+    Warehouse streamed{};
+    addDepartments(streamed);
+    int pulled = 0;
+    picojson::array entries{};
+    streamed.streamDelivery(std::views::iota(0, 8) | std::views::transform([&](int item) {
+                                EXPECT_EQ(static_cast<int>(entries.size()), pulled++);
+                                return createProduct(item);
+                            }),
+                            [&entries](const DeliveryResult &result) { entries.emplace_back(result.asJson()); });
+
+    picojson::object result{};
+    result["deliveryReport"] = picojson::value(std::move(entries));
+    EXPECT_EQ(picojson::value(std::move(result)).serialize(), report);
+    EXPECT_EQ(streamed.saveWarehouseState(), reported.saveWarehouseState());
+}
+
+TEST(WarehouseTest, AtomicDeliveryIsAllOrNothing)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    warehouse.addDepartment(std::make_unique<SpecialDepartment>(3.0));
+    const auto emptyReport = warehouse.getOccupancyReport();
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.0f));
+    products.emplace_back(productFactory.createProduct("TV", "Big TV", 2.5f));
+    products.emplace_back(productFactory.createProduct("ElectronicParts", "Transistor", 0.5f));
+    EXPECT_EQ(warehouse.newAtomicDelivery(products),
+              "{\"deliveryReport\":[{\"assignedDepartment\":\"None\",\"errorLog\":\"Warehouse cannot store this product. "
+              "Consignment rejected.\",\"productName\":\"Glass Plate\",\"status\":\"Fail\"},{\"assignedDepartment\":\"None\","
+              "\"errorLog\":\"Warehouse cannot store this product. Lack of space in departments.\",\"productName\":\"Big "
+              "TV\",\"status\":\"Fail\"},{\"assignedDepartment\":\"None\",\"errorLog\":\"Warehouse cannot store this "
+              "product. Lack of required department.\",\"productName\":\"Transistor\",\"status\":\"Fail\"}]}");
+    EXPECT_EQ(products.size(), 3u);
+    EXPECT_TRUE(products[0] && products[1] && products[2]);
+    EXPECT_EQ(warehouse.getOccupancyReport(), emptyReport);
+
+    products.pop_back();
+    products[1] = productFactory.createProduct("TV", "Small TV", 2.0f);
+    EXPECT_EQ(warehouse.newAtomicDelivery(products),
+              "{\"deliveryReport\":[{\"assignedDepartment\":\"SpecialDepartment\",\"errorLog\":\"\",\"productName\":"
+              "\"Glass Plate\",\"status\":\"Success\"},{\"assignedDepartment\":\"SpecialDepartment\",\"errorLog\":\"\","
+              "\"productName\":\"Small TV\",\"status\":\"Success\"}]}");
+    EXPECT_TRUE(products.empty());
+    EXPECT_EQ(warehouse.newOrder("{\"order\":[{\"name\":\"Small TV\"}]}").products.size(), 1u);
+}
+
+TEST(WarehouseTest, AtomicDeliveryFillsDepartmentsLikeNewDelivery)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    warehouse.addDepartment(std::make_unique<SpecialDepartment>(1.0f));
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    for (int item = 0; item < 10; ++item)
+    {
+        products.emplace_back(productFactory.createProduct("GlassWare", "Glass Chip", 0.1f));
+    }
+    warehouse.newAtomicDelivery(products);
+    EXPECT_TRUE(products.empty());
+
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Chip", 0.1f));
+    warehouse.newAtomicDelivery(products);
+    EXPECT_EQ(products.size(), 1u);
+    EXPECT_EQ(warehouse.newOrder("{\"order\":[{\"name\":\"Glass Chip\"}]}").products.size(), 1u);
+}
+
+namespace
+{
+class RefusingSpecialDepartment : public SpecialDepartment
+{
+public:
+    using SpecialDepartment::SpecialDepartment;
+
+    bool canAdd(const warehouseInterface::IProduct &product) const override
+    {
+        return product.name() != "Glass Vase" && SpecialDepartment::canAdd(product);
+    }
+
+    bool addItem(warehouseInterface::IProductPtr product) override
+    {
+        return product && canAdd(*product) && SpecialDepartment::addItem(std::move(product));
+    }
+};
+
+class OneItemSpecialDepartment : public SpecialDepartment
+{
+    bool full_{false};
+
+public:
+    using SpecialDepartment::SpecialDepartment;
+
+    bool addItem(warehouseInterface::IProductPtr product) override
+    {
+        if (full_ || !SpecialDepartment::addItem(std::move(product)))
+        {
+            return false;
+        }
+        full_ = true;
+        return true;
+    }
+};
+}  // namespace
+
+TEST(WarehouseTest, DeliveriesSkipDepartmentsRefusingProducts)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    auto refusing = std::make_unique<RefusingSpecialDepartment>(10.0f);
+    auto special = std::make_unique<SpecialDepartment>(10.0f);
+    const auto *refusingDepartment = refusing.get();
+    const auto *specialDepartment = special.get();
+    warehouse.addDepartment(std::move(refusing));
+    warehouse.addDepartment(std::move(special));
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Vase", 1.0f));
+    warehouse.newDelivery(std::move(products));
+    EXPECT_EQ(refusingDepartment->getOccupancy(), 0.0f);
+    EXPECT_EQ(specialDepartment->getOccupancy(), 1.0f);
+
+    products.clear();
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.0f));
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Vase", 2.0f));
+    warehouse.newAtomicDelivery(products);
+    EXPECT_TRUE(products.empty());
+    EXPECT_EQ(refusingDepartment->getOccupancy(), 1.0f);
+    EXPECT_EQ(specialDepartment->getOccupancy(), 3.0f);
+}
+
+TEST(WarehouseTest, AtomicDeliveryTakesBackStoredProductsWhenDepartmentRejects)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    auto oneItem = std::make_unique<OneItemSpecialDepartment>(10.0f);
+    const auto *department = oneItem.get();
+    warehouse.addDepartment(std::move(oneItem));
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.0f));
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Cup", 0.5f));
+    EXPECT_EQ(warehouse.newAtomicDelivery(products),
+              "{\"deliveryReport\":[{\"assignedDepartment\":\"None\",\"errorLog\":\"Warehouse cannot store this product. "
+              "Consignment rejected.\",\"productName\":\"Glass Plate\",\"status\":\"Fail\"},{\"assignedDepartment\":"
+              "\"None\",\"errorLog\":\"Warehouse cannot store this product. Lack of space in departments.\",\"productName\""
+              ":\"Glass Cup\",\"status\":\"Fail\"}]}");
+    ASSERT_EQ(products.size(), 2u);
+    ASSERT_TRUE(products[0]);
+    EXPECT_EQ(products[0]->name(), "Glass Plate");
+    EXPECT_FALSE(products[1]);
+    EXPECT_EQ(department->getOccupancy(), 0.0f);
+    EXPECT_TRUE(warehouse.newOrder("{\"order\":[{\"name\":\"Glass Plate\"}]}").products.empty());
+}
+
+TEST(WarehouseTest, ShardedLocksKeepStockConsistent)
+{
+    Warehouse warehouse{ThreadSafety::shardedLocks};
+    for (int department = 0; department < 8; ++department)
+    {
+        warehouse.addDepartment(std::make_unique<SpecialDepartment>(100.0));
+    }
+
+    std::atomic<int> delivered{0};
+    std::atomic<int> picked{0};
+    std::vector<std::thread> threads{};
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&warehouse, &delivered, thread] {
+            ProductFactory productFactory{};
+            for (int batch = 0; batch < 50; ++batch)
+            {
+                std::vector<warehouseInterface::IProductPtr> products{};
+                for (int item = 0; item < 4; ++item)
+                {
+                    const auto name = "Plate " + std::to_string(thread);
+                    products.emplace_back(productFactory.createProduct("GlassWare", name, 1.0f));
+                }
+                const auto report = warehouse.newDelivery(std::move(products));
+                for (auto position = report.find("Success"); position != std::string::npos;
+                     position = report.find("Success", position + 1))
+                {
+                    ++delivered;
+                }
+            }
+        });
+        threads.emplace_back([&warehouse, &picked, thread] {
+            for (int order = 0; order < 200; ++order)
+            {
+                const auto name = "Plate " + std::to_string((thread + 1) % 4);
+                picked += static_cast<int>(warehouse.newOrder("{\"order\":[{\"name\":\"" + name + "\"}]}").products.size());
+            }
+        });
+    }
+    threads.emplace_back([&warehouse] {
+        for (int poll = 0; poll < 50; ++poll)
+        {
+            EXPECT_FALSE(warehouse.getOccupancyReport().empty());
+            EXPECT_FALSE(warehouse.saveWarehouseState().empty());
+        }
+    });
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    picojson::value report;
+    picojson::parse(report, warehouse.getOccupancyReport());
+    double occupancy = 0.0;
+    for (const auto &department : report.get("departmentsOccupancy").get<picojson::array>())
+    {
+        occupancy += department.get("occupancy").get<double>();
+    }
+    EXPECT_EQ(delivered.load(), 800);
+    EXPECT_EQ(occupancy, delivered.load() - picked.load());
+    std::size_t remaining = 0;
+    for (const auto &order : warehouse.newOrders(std::vector<warehouseInterface::OrderJson>(800, "{\"order\":[{}]}")))
+    {
+        remaining += order.products.size();
+    }
+    EXPECT_EQ(static_cast<double>(remaining), occupancy);
+}
+
+TEST(WarehouseTest, OccupancySnapshotsArePointInTime)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    for (int department = 0; department < 300; ++department)
+    {
+        warehouse.addDepartment(std::make_unique<SpecialDepartment>(2.0));
+    }
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.5f));
+    warehouse.newDelivery(std::move(products));
+    const auto before = warehouse.occupancySnapshot();
+
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Cup", 0.5f));
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Jar", 1.0f));
+    warehouse.newDelivery(std::move(products));
+    const auto after = warehouse.occupancySnapshot();
+
+    EXPECT_EQ(before->occupancy(0), 1.5f);
+    EXPECT_EQ(before->occupancy(1), 0.0f);
+    EXPECT_EQ(after->occupancy(0), 2.0f);
+    EXPECT_EQ(after->occupancy(1), 1.0f);
+    EXPECT_GT(after->version, before->version);
+    EXPECT_EQ(after->chunks[1], before->chunks[1]);
+    EXPECT_EQ(after->descriptions, before->descriptions);
+
+    warehouse.newOrder("{\"order\":[{\"name\":\"Glass Cup\"}]}");
+    EXPECT_EQ(warehouse.occupancySnapshot()->occupancy(0), 1.5f);
+    EXPECT_EQ(after->occupancy(0), 2.0f);
+
+    warehouse.addDepartment(std::make_unique<SpecialDepartment>(4.0));
+    const auto grown = warehouse.occupancySnapshot();
+    EXPECT_EQ(grown->departments, 301u);
+    EXPECT_EQ(grown->descriptions[0], after->descriptions[0]);
+    EXPECT_EQ(grown->department(300).maxOccupancy, 4.0f);
+    EXPECT_EQ(after->departments, 300u);
+}
+
+namespace
+{
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object()
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+DetachedTask pickWithCoroutine(OrderGateway &gateway, std::string order, std::promise<std::size_t> &picked)
+{
+    const auto fulfilled = co_await gateway.awaitOrder(std::move(order));
+    picked.set_value(fulfilled.products.size());
+}
+}  // namespace
+
+TEST(WarehouseTest, OrderGatewayFulfilsOrdersAsynchronously)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    warehouse.addDepartment(std::make_unique<SpecialDepartment>(100.0));
+    std::vector<warehouseInterface::IProductPtr> products{};
+    for (int item = 0; item < 60; ++item)
+    {
+        products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.0f));
+    }
+    warehouse.newDelivery(std::move(products));
+
+    std::promise<std::size_t> picked{};
+    std::vector<std::future<warehouseInterface::Order>> orders{};
+    {
+        OrderGateway gateway{warehouse};
+        for (int order = 0; order < 50; ++order)
+        {
+            orders.push_back(gateway.submitOrder("{\"order\":[{\"name\":\"Glass Plate\"}]}"));
+        }
+        pickWithCoroutine(gateway, "{\"order\":[{\"name\":\"Glass Plate\"},{\"name\":\"Glass Cup\"}]}", picked);
+        orders.push_back(gateway.submitOrder("{\"order\":[{\"name\":\"Glass Plate\"}]}"));
+    }
+
+    std::size_t fulfilled = 0;
+    for (auto &order : orders)
+    {
+        fulfilled += order.get().products.size();
+    }
+    EXPECT_EQ(fulfilled, 51U);
+    EXPECT_EQ(picked.get_future().get(), 1U);
+    EXPECT_EQ(warehouse.occupancySnapshot()->occupancy(0), 8.0f);
+}
+
+namespace
+{
+class ShortWavesWarehouse : public Warehouse
+{
+public:
+    std::vector<warehouseInterface::Order> newOrders(std::span<const warehouseInterface::OrderJson> orders) override
+    {
+        auto fulfilled = Warehouse::newOrders(orders);
+        fulfilled.pop_back();
+        return fulfilled;
+    }
+};
+}  // namespace
+
+TEST(WarehouseTest, OrderGatewaySurvivesBrokenWavesAndThrowingCompletions)
+{
+    ShortWavesWarehouse warehouse{};
+    std::future<warehouseInterface::Order> order{};
+    {
+        OrderGateway gateway{warehouse};
+        gateway.submitOrder("{\"order\":[]}", [](std::exception_ptr, warehouseInterface::Order) {
+            throw std::runtime_error("completion failed");
+        });
+        order = gateway.submitOrder("{\"order\":[]}");
+    }
+    EXPECT_THROW(order.get(), std::length_error);
+}
+
+TEST(WarehouseTest, EngineAppliesCommandsInQueueOrder)
+{
+    WarehouseEngine engine{PlacementPolicy::firstFit, 16};
+    engine.addDepartment(std::make_unique<SpecialDepartment>(1000.0));
+    engine.pinToCpu(0);
+
+    std::vector<std::thread> producers{};
+    std::atomic<std::size_t> picked{0};
+    for (int producer = 0; producer < 4; ++producer)
+    {
+        producers.emplace_back([&engine, &picked] {
+            ProductFactory productFactory{};
+            std::vector<std::future<warehouseInterface::Order>> orders{};
+            for (int item = 0; item < 100; ++item)
+            {
+                std::vector<warehouseInterface::IProductPtr> products{};
+                products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.0f));
+                engine.newDelivery(std::move(products));
+                orders.push_back(engine.newOrder("{\"order\":[{\"name\":\"Glass Plate\"}]}"));
+            }
+            for (auto &order : orders)
+            {
+                picked += order.get().products.size();
+            }
+        });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_EQ(picked.load(), 400U);
+    picojson::value report;
+    picojson::parse(report, engine.getOccupancyReport().get());
+    const auto &departments = report.get("departmentsOccupancy").get<picojson::array>();
+    ASSERT_EQ(departments.size(), 1U);
+    EXPECT_EQ(departments[0].get("occupancy").get<double>(), 0.0);
+    EXPECT_EQ(engine.occupancySnapshot()->occupancy(0), 0.0f);
+}
+
+TEST(WarehouseTest, AtomicOrdersReserveAndCommitAllLines)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    warehouse.addDepartment(std::make_unique<SpecialDepartment>(10.0));
+    warehouse.addDepartment(std::make_unique<HazardousDepartment>(100.0));
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.5f));
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Cup", 0.5f));
+    products.emplace_back(productFactory.createProduct("AcetoneBarrel", "Acetone Barrel", 25.0f));
+    warehouse.newDelivery(std::move(products));
+    const auto report = warehouse.getOccupancyReport();
+
+    const auto failed = warehouse.newAtomicOrder(
+            "{\"order\":[{\"name\":\"Glass Cup\"},{\"name\":\"Acetone Barrel\"},{\"name\":\"TV\"}]}");
+    EXPECT_TRUE(failed.products.empty());
+    EXPECT_EQ(warehouse.getOccupancyReport(), report);
+
+    auto reservation = warehouse.reserveOrder("{\"order\":[{\"name\":\"Glass Cup\"},{\"name\":\"Glass Plate\"}]}");
+    ASSERT_TRUE(reservation.has_value());
+    EXPECT_EQ(warehouse.getOccupancyReport(), report);
+    EXPECT_TRUE(warehouse.newOrder("{\"order\":[{\"name\":\"Glass Cup\"}]}").products.empty());
+    EXPECT_FALSE(warehouse.reserveOrder("{\"order\":[{\"name\":\"Glass Plate\"}]}").has_value());
+
+    warehouse.releaseOrder(std::move(*reservation));
+    reservation = warehouse.reserveOrder(
+            "{\"order\":[{\"name\":\"Glass Cup\"},{\"name\":\"Glass Plate\"},{\"name\":\"Acetone Barrel\"}]}");
+    ASSERT_TRUE(reservation.has_value());
+    const auto order = warehouse.commitOrder(std::move(*reservation));
+    ASSERT_EQ(order.products.size(), 3U);
+    EXPECT_EQ(order.products[0]->name(), "Glass Cup");
+    EXPECT_EQ(order.products[1]->name(), "Glass Plate");
+    EXPECT_EQ(warehouse.occupancySnapshot()->occupancy(0), 0.0f);
+    EXPECT_EQ(warehouse.occupancySnapshot()->occupancy(1), 0.0f);
+    EXPECT_EQ(warehouse.saveWarehouseState().find("Glass"), std::string::npos);
+}
+
+namespace
+{
+class ColumnarSpecialDepartment : public SpecialDepartment
+{
+public:
+    explicit ColumnarSpecialDepartment(float maxOccupancy) : SpecialDepartment(maxOccupancy)
+    {
+        useColumnarStorage();
+    }
+};
+}  // namespace
+
+TEST(WarehouseTest, ColumnarDepartmentsServeDeliveriesAndOrders)
+{
+    ProductFactory productFactory{};
+    Warehouse warehouse{};
+    warehouse.addDepartment(std::make_unique<ColumnarSpecialDepartment>(10.0));
+
+    std::vector<warehouseInterface::IProductPtr> products{};
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Plate", 1.5f));
+    products.emplace_back(productFactory.createProduct("GlassWare", "Glass Cup", 0.5f));
+    warehouse.newDelivery(std::move(products));
+    EXPECT_EQ(warehouse.occupancySnapshot()->occupancy(0), 2.0f);
+
+    EXPECT_TRUE(warehouse.newOrder("{\"order\":[{\"name\":\"Glass Plate\"}]}").products.empty());
+    auto reservation = warehouse.reserveOrder("{\"order\":[{\"name\":\"Glass Cup\"},{\"name\":\"Glass Plate\"}]}");
+    ASSERT_TRUE(reservation.has_value());
+    const auto order = warehouse.commitOrder(std::move(*reservation));
+    ASSERT_EQ(order.products.size(), 2U);
+    EXPECT_EQ(order.products[0]->name(), "Glass Cup");
+    EXPECT_EQ(order.products[1]->itemSize(), 1.5f);
+    EXPECT_EQ(order.products[1]->classId(), ProductFactory::classId("GlassWare"));
+    EXPECT_EQ(warehouse.occupancySnapshot()->occupancy(0), 0.0f);
+}
+
+}  // namespace warehouse
@@ -7,6 +7,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -29,11 +30,52 @@ TEST_P(ProductFactoryTest, CreateProduct)
     ASSERT_NE(nullptr, productPtr);
     EXPECT_EQ(name, productPtr->name());
     EXPECT_FLOAT_EQ(size, productPtr->itemSize());
+    EXPECT_EQ(productPtr->classId(), ProductFactory::classId(className));
+    EXPECT_EQ(ProductFactory::className(productPtr->classId()), className);
+    EXPECT_EQ(productPtr->nameView(), name);
+    EXPECT_EQ(productPtr->nameSymbol(), factory.createProduct(className, name, size)->nameSymbol());
 }
 
 TEST_F(ProductFactoryTest, UnknownProduct)
 {
     EXPECT_THROW(factory.createProduct("Unknown class", "nope", -1.0), std::runtime_error);
+    EXPECT_EQ(ProductFactory::classId("Unknown class"), warehouseInterface::anyProductClass);
+}
+
+TEST_F(ProductFactoryTest, ProductsReuseArenaBlocks)
+{
+    auto first = factory.createProduct("TV", "Smart TV", 15.0f);
+    ASSERT_TRUE(first.get_deleter().pooled());
+    EXPECT_FALSE(warehouseInterface::IProductPtr{std::make_unique<TV>("Smart TV", 15.0f)}.get_deleter().pooled());
+
+    const auto *block = first.get();
+    first.reset();
+    auto second = factory.createProduct("TV", "Other TV", 5.0f);
+    EXPECT_EQ(second.get(), block);
+    EXPECT_EQ(second->name(), "Other TV");
+}
+
+TEST_F(ProductFactoryTest, BulkReleaseReturnsBlocksAtTheEnd)
+{
+    std::vector<warehouseInterface::IProductPtr> products{};
+    std::set<const warehouseInterface::IProduct *> blocks{};
+    for (int product = 0; product < 100; ++product)
+    {
+        products.push_back(factory.createProduct("GlassWare", "Glass", 0.5f));
+        blocks.insert(products.back().get());
+    }
+    warehouseInterface::IProductPtr created{};
+    {
+        const warehouseInterface::BulkRelease bulkRelease{};
+        products.clear();
+        created = factory.createProduct("GlassWare", "Glass", 0.5f);
+        EXPECT_FALSE(blocks.contains(created.get()));
+    }
+    for (int product = 0; product < 100; ++product)
+    {
+        products.push_back(factory.createProduct("GlassWare", "Glass", 0.5f));
+        EXPECT_TRUE(blocks.contains(products.back().get()));
+    }
 }
 
 INSTANTIATE_TEST_SUITE_P(ProductFactoryTestInstantiation,
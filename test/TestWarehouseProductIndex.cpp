@@ -0,0 +1,534 @@
+#include <PicoJson/picojson.h>
+#include <gtest/gtest.h>
+
+#include <Factory/ProductFactory.hpp>
+#include <Interfaces/ColumnarStorage.hpp>
+#include <Interfaces/InternTable.hpp>
+#include <Interfaces/OccupancyCounter.hpp>
+#include <Interfaces/ProductIndex.hpp>
+#include <Interfaces/ProductQuery.hpp>
+#include <Interfaces/ScanKernels.hpp>
+#include <Products/ProductsList.hpp>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace warehouse
+{
+namespace
+{
+warehouseInterface::ProductClassId classId(const std::string &className)
+{
+    return warehouseInterface::ProductClassTable::instance().intern(className);
+}
+
+warehouseInterface::NameSymbol nameSymbol(const std::string &name)
+{
+    return warehouseInterface::NamePool::instance().intern(name);
+}
+
+/**
+ * @brief A product class unknown to the ProductFactory.
+ */
+class HandmadeVase : public warehouseInterface::IProduct
+{
+public:
+    std::string name() const override
+    {
+        return "Handmade Vase";
+    }
+
+    float itemSize() const override
+    {
+        return 2.0f;
+    }
+
+    warehouseInterface::ProductLabelFlags itemFlags() const override
+    {
+        return warehouseInterface::ProductLabelFlags::fragile;
+    }
+
+    picojson::object asJson() const override
+    {
+        picojson::object json{};
+        json["class"] = picojson::value("HandmadeVase");
+        json["name"] = picojson::value(name());
+        json["size"] = picojson::value(static_cast<double>(itemSize()));
+        return json;
+    }
+
+    warehouseInterface::ProductDescriptionJson serialize() const override
+    {
+        return picojson::value(asJson()).serialize();
+    }
+};
+}  // namespace
+
+TEST(ProductIndexTest, ExactKeyIsFifo)
+{
+    warehouseInterface::ProductIndex index{};
+
+    for (int i = 0; i < 3; ++i)
+    {
+        index.insert(std::make_unique<AstronautsIceCream>("Vanilla", 0.5f));
+    }
+    index.insert(std::make_unique<GlassWare>("Vanilla", 1.0f));
+
+    EXPECT_EQ(index.size(), 4);
+    EXPECT_EQ(index.extract(classId("AcetoneBarrel"), nameSymbol("Vanilla")), nullptr);
+
+    auto glass = index.extract(classId("GlassWare"), nameSymbol("Vanilla"));
+    ASSERT_NE(glass, nullptr);
+    EXPECT_EQ(glass->itemSize(), 1.0f);
+    EXPECT_EQ(index.size(), 3);
+}
+
+TEST(ProductIndexTest, FirstStoredIsReturnedFirst)
+{
+    warehouseInterface::ProductIndex index{};
+
+    std::vector<warehouseInterface::IProduct *> productsRawPtrs{};
+    for (const auto *name : {"0", "1", "0", "1"})
+    {
+        auto product = std::make_unique<AstronautsIceCream>(name, 2.0f);
+        productsRawPtrs.push_back(product.get());
+        index.insert(std::move(product));
+    }
+
+    EXPECT_EQ(index.extract(classId("AstronautsIceCream"), nameSymbol("1")).get(), productsRawPtrs[1]);
+    EXPECT_EQ(index.extract(classId("AstronautsIceCream"), warehouseInterface::anyName).get(), productsRawPtrs[0]);
+    EXPECT_EQ(index.extract(warehouseInterface::anyProductClass, nameSymbol("0")).get(), productsRawPtrs[2]);
+    EXPECT_EQ(index.extract(classId("AstronautsIceCream"), nameSymbol("0")), nullptr);
+    EXPECT_EQ(index.extract(classId("AstronautsIceCream"), nameSymbol("1")).get(), productsRawPtrs[3]);
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(ProductIndexTest, PartialDescriptionsShareIndexes)
+{
+    warehouseInterface::ProductIndex index{};
+
+    std::vector<warehouseInterface::IProduct *> productsRawPtrs{};
+    const std::vector<std::pair<std::string, std::string>> stock{
+            {"AstronautsIceCream", "Vanilla"}, {"GlassWare", "Chocolate"}, {"AstronautsIceCream", "Chocolate"}};
+    for (const auto &[productClass, name] : stock)
+    {
+        warehouseInterface::IProductPtr product{};
+        if (productClass == "GlassWare")
+        {
+            product = std::make_unique<GlassWare>(name, 1.0f);
+        }
+        else
+        {
+            product = std::make_unique<AstronautsIceCream>(name, 1.0f);
+        }
+        productsRawPtrs.push_back(product.get());
+        index.insert(std::move(product));
+    }
+
+    EXPECT_EQ(index.extract(warehouseInterface::anyProductClass, nameSymbol("Chocolate")).get(), productsRawPtrs[1]);
+    EXPECT_EQ(index.extract(classId("GlassWare"), warehouseInterface::anyName), nullptr);
+    EXPECT_EQ(index.extract(classId("AstronautsIceCream"), nameSymbol("Chocolate")).get(), productsRawPtrs[2]);
+    EXPECT_EQ(index.extract(warehouseInterface::anyProductClass, nameSymbol("Chocolate")), nullptr);
+    EXPECT_EQ(index.extract(classId("AstronautsIceCream"), warehouseInterface::anyName).get(), productsRawPtrs[0]);
+    EXPECT_EQ(index.extract(warehouseInterface::anyProductClass, warehouseInterface::anyName), nullptr);
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(ProductIndexTest, FrontAndBackAccess)
+{
+    warehouseInterface::ProductIndex index{};
+
+    index.insert(std::make_unique<AcetoneBarrel>("Small Acetone Barrel", 25.0f));
+    index.insert(std::make_unique<ExplosiveBarrel>("Explosive Barrel", 25.0f));
+    index.insert(std::make_unique<AcetoneBarrel>("Big Acetone Barrel", 75.0f));
+
+    EXPECT_EQ(index.extractFront(classId("ExplosiveBarrel"), warehouseInterface::anyName), nullptr);
+    EXPECT_EQ(index.extractBack(classId("AcetoneBarrel"), nameSymbol("Small Acetone Barrel")), nullptr);
+
+    auto front = index.extractFront(classId("AcetoneBarrel"), warehouseInterface::anyName);
+    ASSERT_NE(front, nullptr);
+    EXPECT_EQ(front->name(), "Small Acetone Barrel");
+
+    auto back = index.extractBack(warehouseInterface::anyProductClass, nameSymbol("Big Acetone Barrel"));
+    ASSERT_NE(back, nullptr);
+    EXPECT_EQ(back->itemSize(), 75.0f);
+
+    auto last = index.extract(classId("ExplosiveBarrel"), nameSymbol("Explosive Barrel"));
+    ASSERT_NE(last, nullptr);
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(ProductIndexTest, ReservedProductsAreHidden)
+{
+    warehouseInterface::ProductIndex index{};
+
+    index.insert(std::make_unique<AcetoneBarrel>("Small Acetone Barrel", 25.0f));
+    index.insert(std::make_unique<AcetoneBarrel>("Big Acetone Barrel", 75.0f));
+
+    const auto small = index.reserveFront(classId("AcetoneBarrel"), warehouseInterface::anyName);
+    ASSERT_TRUE(small);
+    EXPECT_FALSE(index.reserveBack(warehouseInterface::anyProductClass, nameSymbol("Small Acetone Barrel")));
+    const auto big = index.reserve(classId("AcetoneBarrel"), warehouseInterface::anyName);
+    ASSERT_TRUE(big);
+    EXPECT_EQ(index.extract(warehouseInterface::anyProductClass, warehouseInterface::anyName), nullptr);
+    EXPECT_EQ(index.size(), 2);
+
+    index.release(small);
+    auto front = index.extractFront(warehouseInterface::anyProductClass, warehouseInterface::anyName);
+    ASSERT_NE(front, nullptr);
+    EXPECT_EQ(front->name(), "Small Acetone Barrel");
+    EXPECT_EQ(index.extractBack(warehouseInterface::anyProductClass, warehouseInterface::anyName), nullptr);
+
+    auto committed = index.commit(big);
+    ASSERT_NE(committed, nullptr);
+    EXPECT_EQ(committed->itemSize(), 75.0f);
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(ProductIndexTest, IgnoresStaleReservations)
+{
+    warehouseInterface::ProductIndex index{};
+    warehouseInterface::ProductIndex other{};
+    for (const auto *name : {"Small Acetone Barrel", "Big Acetone Barrel", "Huge Acetone Barrel"})
+    {
+        index.insert(std::make_unique<AcetoneBarrel>(name, 25.0f));
+    }
+    other.insert(std::make_unique<AcetoneBarrel>("Other Acetone Barrel", 25.0f));
+
+    const auto committed = index.reserve(warehouseInterface::anyProductClass, nameSymbol("Big Acetone Barrel"));
+    const auto released = index.reserve(warehouseInterface::anyProductClass, nameSymbol("Small Acetone Barrel"));
+    ASSERT_NE(index.commit(committed), nullptr);
+    index.release(released);
+    const auto foreign = other.reserve(warehouseInterface::anyProductClass, warehouseInterface::anyName);
+
+    EXPECT_EQ(index.commit(committed), nullptr);
+    EXPECT_EQ(index.commit(released), nullptr);
+    index.release(committed);
+    EXPECT_EQ(index.commit(foreign), nullptr);
+    EXPECT_EQ(index.size(), 2u);
+    const auto small = index.reserve(warehouseInterface::anyProductClass, nameSymbol("Small Acetone Barrel"));
+    EXPECT_EQ(index.extract(warehouseInterface::anyProductClass, warehouseInterface::anyName)->name(),
+              "Huge Acetone Barrel");
+    EXPECT_EQ(index.commit(small)->name(), "Small Acetone Barrel");
+    EXPECT_EQ(other.commit(foreign)->name(), "Other Acetone Barrel");
+}
+
+TEST(InternTableTest, ThrowsWhenAllIdsAreAssigned)
+{
+    using SmallTable = warehouseInterface::InternTable<std::uint8_t, struct SmallTableTag>;
+    auto &table = SmallTable::instance();
+    for (int string = 0; string < SmallTable::any; ++string)
+    {
+        EXPECT_EQ(table.intern(std::to_string(string)), string);
+    }
+    EXPECT_EQ(table.intern("0"), 0);
+    EXPECT_THROW(table.intern("any"), std::length_error);
+    EXPECT_EQ(table.find("any"), SmallTable::any);
+}
+
+TEST(ColumnarStorageTest, MaterializesProductsOnTheWayOut)
+{
+    const ProductFactory productFactory{};
+    warehouseInterface::ColumnarStorage storage{};
+
+    storage.insert(productFactory.createProduct("AcetoneBarrel", "Small Acetone Barrel", 25.0f));
+    storage.insert(productFactory.createProduct("ExplosiveBarrel", "Explosive Barrel", 25.0f));
+    storage.insert(productFactory.createProduct("AcetoneBarrel", "Big Acetone Barrel", 75.0f));
+    EXPECT_EQ(storage.size(), 3);
+    EXPECT_EQ(storage.totalUnits(), warehouseInterface::OccupancyCounter::toUnits(125.0f));
+
+    std::vector<float> sizes{};
+    storage.forEachRow([&sizes](auto, auto, float size, auto) { sizes.push_back(size); });
+    EXPECT_EQ(sizes, (std::vector<float>{25.0f, 25.0f, 75.0f}));
+
+    EXPECT_EQ(storage.extractFront(classId("ExplosiveBarrel"), warehouseInterface::anyName), nullptr);
+    EXPECT_EQ(storage.extractBack(classId("AcetoneBarrel"), nameSymbol("Small Acetone Barrel")), nullptr);
+
+    const auto explosive = storage.reserve(classId("ExplosiveBarrel"), warehouseInterface::anyName);
+    ASSERT_TRUE(explosive);
+    auto front = storage.extractFront(classId("AcetoneBarrel"), warehouseInterface::anyName);
+    ASSERT_NE(front, nullptr);
+    EXPECT_EQ(front->name(), "Small Acetone Barrel");
+    EXPECT_EQ(front->classId(), classId("AcetoneBarrel"));
+    EXPECT_EQ(storage.extract(classId("ExplosiveBarrel"), warehouseInterface::anyName), nullptr);
+
+    storage.release(explosive);
+    auto back = storage.extractBack(warehouseInterface::anyProductClass, nameSymbol("Big Acetone Barrel"));
+    ASSERT_NE(back, nullptr);
+    EXPECT_EQ(back->itemSize(), 75.0f);
+    auto last = storage.commit(storage.reserveFront(warehouseInterface::anyProductClass, warehouseInterface::anyName));
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(last->name(), "Explosive Barrel");
+    EXPECT_TRUE(storage.empty());
+}
+
+TEST(ColumnarStorageTest, BuildsJsonFromClassDescriptors)
+{
+    const ProductFactory productFactory{};
+    warehouseInterface::ColumnarStorage storage{};
+    std::vector<warehouseInterface::ProductDescriptionJson> expected{};
+    const std::vector<std::pair<std::string, std::string>> products{
+            {"TV", "Sony Bravia"}, {"GlassWare", "Crystal \"Vase\""}, {"TV", "LG OLED"}};
+    for (const auto &[className, name] : products)
+    {
+        auto product = productFactory.createProduct(className, name, 1.5f);
+        expected.push_back(product->serialize());
+        storage.insert(std::move(product));
+    }
+    storage.insert(std::make_unique<HandmadeVase>());
+    expected.push_back(HandmadeVase{}.serialize());
+
+    std::vector<warehouseInterface::ProductDescriptionJson> serialized{};
+    storage.forEachJson([&serialized](picojson::object item) {
+        serialized.push_back(picojson::value(std::move(item)).serialize());
+    });
+    EXPECT_EQ(serialized, expected);
+}
+
+TEST(ColumnarStorageTest, RemovesRowsInTheMiddle)
+{
+    const ProductFactory productFactory{};
+    warehouseInterface::ColumnarStorage storage{};
+    for (int item = 0; item < 8; ++item)
+    {
+        storage.insert(productFactory.createProduct("TV", "TV " + std::to_string(item), static_cast<float>(item)));
+    }
+
+    for (const auto item : {3, 5, 1, 7, 0})
+    {
+        const auto product = storage.extract(warehouseInterface::anyProductClass, nameSymbol("TV " + std::to_string(item)));
+        ASSERT_NE(product, nullptr);
+        EXPECT_EQ(product->name(), "TV " + std::to_string(item));
+    }
+    storage.insert(productFactory.createProduct("TV", "TV 8", 8.0f));
+    EXPECT_EQ(storage.size(), 4u);
+    EXPECT_EQ(storage.totalUnits(), warehouseInterface::OccupancyCounter::toUnits(2.0f + 4.0f + 6.0f + 8.0f));
+
+    std::vector<std::string> names{};
+    storage.forEach([&names](const warehouseInterface::IProduct &product) { names.push_back(product.name()); });
+    EXPECT_EQ(names, (std::vector<std::string>{"TV 2", "TV 4", "TV 6", "TV 8"}));
+    EXPECT_EQ(storage.extractFront(warehouseInterface::anyProductClass, warehouseInterface::anyName)->name(), "TV 2");
+    EXPECT_EQ(storage.extractBack(warehouseInterface::anyProductClass, warehouseInterface::anyName)->name(), "TV 8");
+    EXPECT_EQ(storage.extract(warehouseInterface::anyProductClass, nameSymbol("TV 6"))->name(), "TV 6");
+    EXPECT_EQ(storage.extract(warehouseInterface::anyProductClass, warehouseInterface::anyName)->name(), "TV 4");
+    EXPECT_TRUE(storage.empty());
+}
+
+TEST(ColumnarStorageTest, IgnoresStaleReservations)
+{
+    const ProductFactory productFactory{};
+    warehouseInterface::ColumnarStorage storage{};
+    warehouseInterface::ColumnarStorage other{};
+    for (const auto *name : {"Sony", "LG", "Philips"})
+    {
+        storage.insert(productFactory.createProduct("TV", name, 1.0f));
+    }
+    other.insert(productFactory.createProduct("TV", "Samsung", 1.0f));
+
+    const auto committed = storage.reserve(warehouseInterface::anyProductClass, nameSymbol("LG"));
+    const auto released = storage.reserve(warehouseInterface::anyProductClass, nameSymbol("Sony"));
+    ASSERT_NE(storage.commit(committed), nullptr);
+    storage.release(released);
+    const auto foreign = other.reserve(warehouseInterface::anyProductClass, warehouseInterface::anyName);
+
+    EXPECT_EQ(storage.commit(committed), nullptr);
+    EXPECT_EQ(storage.commit(released), nullptr);
+    storage.release(committed);
+    EXPECT_EQ(storage.commit(foreign), nullptr);
+    EXPECT_EQ(storage.size(), 2u);
+    const auto sony = storage.reserve(warehouseInterface::anyProductClass, nameSymbol("Sony"));
+    EXPECT_EQ(storage.extract(warehouseInterface::anyProductClass, warehouseInterface::anyName)->name(), "Philips");
+    EXPECT_EQ(storage.commit(sony)->name(), "Sony");
+    EXPECT_EQ(other.commit(foreign)->name(), "Samsung");
+}
+
+TEST(ColumnarStorageTest, KeepsProductsWithoutBuilder)
+{
+    warehouseInterface::ColumnarStorage storage{};
+    auto product = std::make_unique<HandmadeVase>();
+    const auto *object = product.get();
+    storage.insert(std::move(product));
+
+    std::size_t visited = 0;
+    storage.forEach([&visited, object](const warehouseInterface::IProduct &stored) {
+        EXPECT_EQ(&stored, object);
+        ++visited;
+    });
+    EXPECT_EQ(visited, 1);
+    EXPECT_EQ(storage.extract(warehouseInterface::anyProductClass, nameSymbol("Handmade Vase")).get(), object);
+}
+
+TEST(ScanKernelsTest, AllKernelsFindTheSameRow)
+{
+    std::mt19937 random{7};
+    const std::size_t rows = 1000;
+    std::vector<warehouseInterface::ProductClassId> classes(rows);
+    std::vector<warehouseInterface::NameSymbol> names(rows);
+    std::vector<float> sizes(rows);
+    std::vector<warehouseInterface::ProductLabelFlags> flags(rows);
+    std::vector<std::uint8_t> reserved(rows);
+    for (std::size_t row = 0; row < rows; ++row)
+    {
+        classes[row] = static_cast<warehouseInterface::ProductClassId>(random() % 7);
+        names[row] = static_cast<warehouseInterface::NameSymbol>(random() % 50);
+        sizes[row] = static_cast<float>(random() % 100) / 4.0f;
+        flags[row] = static_cast<warehouseInterface::ProductLabelFlags>(random() % 256);
+        reserved[row] = random() % 5 == 0;
+    }
+    const warehouseInterface::ColumnsView columns{classes.data(), names.data(), sizes.data(), flags.data(), reserved.data()};
+
+    using Kernel = warehouseInterface::ScanKernels::Kernel;
+    for (int query = 0; query < 500; ++query)
+    {
+        warehouseInterface::RowFilter filter{};
+        filter.productClass = random() % 3 == 0 ? warehouseInterface::anyProductClass
+                                                : static_cast<warehouseInterface::ProductClassId>(random() % 8);
+        filter.name = random() % 2 == 0 ? warehouseInterface::anyName : static_cast<warehouseInterface::NameSymbol>(random() % 60);
+        filter.requiredFlags = random() % 2 == 0 ? 0U : 1U << (random() % 8);
+        filter.minSize = random() % 2 == 0 ? filter.minSize : static_cast<float>(random() % 25);
+        filter.maxSize = random() % 2 == 0 ? filter.maxSize : filter.minSize + static_cast<float>(random() % 10);
+        const auto from = static_cast<std::size_t>(random() % rows);
+        const auto to = from + static_cast<std::size_t>(random() % (rows - from + 1));
+
+        const auto expected = warehouseInterface::ScanKernels::findFirst(columns, from, to, filter, Kernel::scalar);
+        EXPECT_EQ(warehouseInterface::ScanKernels::findFirst(columns, from, to, filter, Kernel::sse42), expected);
+        EXPECT_EQ(warehouseInterface::ScanKernels::findFirst(columns, from, to, filter, Kernel::avx2), expected);
+    }
+}
+
+TEST(ScanKernelsTest, EveryKernelFindsUnalignedAndTailRows)
+{
+    const std::size_t rows = 40;
+    std::vector<warehouseInterface::ProductClassId> classes(rows, 1);
+    std::vector<warehouseInterface::NameSymbol> names(rows, 1);
+    std::vector<float> sizes(rows, 1.0f);
+    std::vector<warehouseInterface::ProductLabelFlags> flags(rows, warehouseInterface::ProductLabelFlags::fragile);
+    std::vector<std::uint8_t> reserved(rows, 0);
+    const warehouseInterface::ColumnsView columns{classes.data(), names.data(), sizes.data(), flags.data(), reserved.data()};
+    const warehouseInterface::RowFilter filter{2, 7, static_cast<unsigned>(warehouseInterface::ProductLabelFlags::keepDry),
+                                               2.0f, 3.0f};
+
+    using Kernel = warehouseInterface::ScanKernels::Kernel;
+    for (const auto kernel : {Kernel::scalar, Kernel::sse42, Kernel::avx2})
+    {
+        for (std::size_t from = 0; from < 10; ++from)
+        {
+            for (auto match = from; match < rows; ++match)
+            {
+                // Matching rows before the match are reserved, the rows after it match too.
+                for (auto row = from; row < rows; ++row)
+                {
+                    const auto matching = row >= match || (row - from) % 3 == 0;
+                    classes[row] = matching ? 2 : 1;
+                    names[row] = matching ? 7 : 1;
+                    sizes[row] = matching ? 2.5f : 1.0f;
+                    flags[row] = matching ? warehouseInterface::ProductLabelFlags::keepDry
+                                          : warehouseInterface::ProductLabelFlags::fragile;
+                    reserved[row] = row < match && matching;
+                }
+                EXPECT_EQ(warehouseInterface::ScanKernels::findFirst(columns, from, rows, filter, kernel), match)
+                        << "kernel " << static_cast<int>(kernel) << " from " << from;
+                EXPECT_EQ(warehouseInterface::ScanKernels::findFirst(columns, from, match, filter, kernel), match);
+            }
+        }
+    }
+}
+
+TEST(ColumnarStorageTest, ExtractsByFlagsAndSize)
+{
+    const ProductFactory productFactory{};
+    warehouseInterface::ColumnarStorage storage{};
+    for (int product = 0; product < 20; ++product)
+    {
+        storage.insert(productFactory.createProduct("GlassWare", "Glass", static_cast<float>(product)));
+        storage.insert(productFactory.createProduct("ExplosiveBarrel", "Barrel", static_cast<float>(product)));
+    }
+
+    warehouseInterface::RowFilter filter{};
+    filter.requiredFlags = static_cast<unsigned>(productFactory.createProduct("ExplosiveBarrel", "Barrel", 1.0f)->itemFlags());
+    filter.minSize = 12.5f;
+    auto barrel = storage.extract(filter);
+    ASSERT_NE(barrel, nullptr);
+    EXPECT_EQ(barrel->name(), "Barrel");
+    EXPECT_EQ(barrel->itemSize(), 13.0f);
+
+    filter.maxSize = 12.9f;
+    EXPECT_EQ(storage.extract(filter), nullptr);
+    EXPECT_EQ(storage.size(), 39);
+}
+
+TEST(ProductQueryTest, CompilesDescriptions)
+{
+    const auto exact = warehouseInterface::ProductQuery::compile(
+            warehouseInterface::ProductDescriptionJson{"{\"name\": \"Vanilla\", \"class\": \"AstronautsIceCream\"}"});
+    EXPECT_TRUE(exact.satisfiable);
+    EXPECT_EQ(exact.productClass, classId("AstronautsIceCream"));
+    EXPECT_EQ(exact.name, nameSymbol("Vanilla"));
+    EXPECT_EQ(warehouseInterface::ProductQuery::compile(exact.serialize()).name, exact.name);
+
+    const auto onlyClass =
+            warehouseInterface::ProductQuery::compile(warehouseInterface::ProductDescriptionJson{"{\"class\": \"GlassWare\"}"});
+    EXPECT_TRUE(onlyClass.satisfiable);
+    EXPECT_EQ(onlyClass.name, warehouseInterface::anyName);
+
+    EXPECT_FALSE(warehouseInterface::ProductQuery::compile(
+                         warehouseInterface::ProductDescriptionJson{"{\"name\": \"Never Delivered Product\"}"})
+                         .satisfiable);
+    EXPECT_FALSE(warehouseInterface::ProductQuery::compile(warehouseInterface::ProductDescriptionJson{"{'class':'TV'}"})
+                         .satisfiable);
+}
+
+TEST(ProductQueryTest, CompilesOrders)
+{
+    const auto order = warehouseInterface::OrderQuery::compile(
+            "{\"order\": [{\"class\":\"GlassWare\"}, \"GlassWare\", {\"class\":\"Unknown class\"}]}");
+    ASSERT_EQ(order.lines.size(), 2);
+    EXPECT_EQ(order.lines[0].productClass, classId("GlassWare"));
+    EXPECT_FALSE(order.lines[1].satisfiable);
+    EXPECT_TRUE(warehouseInterface::OrderQuery::compile("{'order':[]}").lines.empty());
+}
+
+TEST(OccupancyCounterTest, StoringAndTakingDoesNotDrift)
+{
+    warehouseInterface::OccupancyCounter occupancy{};
+    for (int item = 0; item < 1000000; ++item)
+    {
+        occupancy += 0.1f;
+    }
+    EXPECT_EQ(occupancy.units(), 100000000000);
+    EXPECT_EQ(static_cast<float>(occupancy), 100000.0f);
+    for (int item = 0; item < 1000000; ++item)
+    {
+        occupancy -= 0.1f;
+    }
+    EXPECT_EQ(occupancy.units(), 0);
+    EXPECT_EQ(static_cast<float>(occupancy), 0.0f);
+
+    occupancy = 10.5f;
+    EXPECT_EQ(static_cast<float>(occupancy), 10.5f);
+    EXPECT_EQ(warehouseInterface::OccupancyCounter::toUnits(std::numeric_limits<float>::max()), 9200000000000000000);
+}
+
+TEST(OccupancyCounterTest, ConcurrentUpdatesAreNotLost)
+{
+    warehouseInterface::OccupancyCounter occupancy{};
+    std::vector<std::thread> threads{};
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&occupancy] {
+            for (int item = 0; item < 10000; ++item)
+            {
+                occupancy += 0.25f;
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(static_cast<float>(occupancy), 10000.0f);
+}
+
+}  // namespace warehouse
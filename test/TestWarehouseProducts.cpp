@@ -2,7 +2,10 @@
 #include <PicoJson/picojson.h>
 #include <gtest/gtest.h>
 
+#include <Factory/ProductFactory.hpp>
+#include <Products/ProductValue.hpp>
 #include <Products/ProductsList.hpp>
+#include <vector>
 #include <iostream>
 
 namespace warehouse
@@ -297,4 +300,84 @@ TEST(IndustrialServerRackTest, NameAndSizeTest)
     EXPECT_EQ(rack.itemSize(), size);
 }
 
-}  // namespace warehouse
\ No newline at end of file
+TEST(ProductValueTest, MatchesTheProductInterface)
+{
+    const ProductFactory factory{};
+    std::vector<ProductValue> values{};
+    for (const auto *className : {"AcetoneBarrel", "AstronautsIceCream", "ElectronicParts", "ExplosiveBarrel", "GlassWare",
+                                  "IndustrialServerRack", "TV"})
+    {
+        values.push_back(factory.createValue(className, std::string{"Value "} + className, 2.5f));
+        const auto product = factory.createProduct(className, std::string{"Value "} + className, 2.5f);
+        const auto &value = values.back();
+
+        EXPECT_EQ(value.name(), product->name());
+        EXPECT_EQ(value.asProduct().nameSymbol(), product->nameSymbol());
+        EXPECT_EQ(value.asProduct().classId(), product->classId());
+        EXPECT_EQ(value.itemSize(), product->itemSize());
+        EXPECT_EQ(value.itemFlags(), product->itemFlags());
+        EXPECT_EQ(picojson::value(value.asJson()).serialize(), product->serialize());
+    }
+    EXPECT_THROW(factory.createValue("Unknown class", "nope", 1.0f), std::runtime_error);
+}
+
+TEST(ProductValueTest, ConvertsToAndFromProductPointers)
+{
+    const ProductValue value{TV("Sony Bravia", 50.0f)};
+    const auto product = value.toProductPtr();
+    ASSERT_NE(product, nullptr);
+    EXPECT_TRUE(product.get_deleter().pooled());
+    EXPECT_NE(dynamic_cast<const TV *>(product.get()), nullptr);
+    EXPECT_EQ(product->serialize(), value.asProduct().serialize());
+
+    const auto copy = ProductValue::fromProduct(*product);
+    ASSERT_TRUE(copy.has_value());
+    EXPECT_EQ(copy->name(), "Sony Bravia");
+    EXPECT_TRUE(copy->visit(
+            [](const auto &stored) { return std::is_same_v<std::remove_cvref_t<decltype(stored)>, TV>; }));
+}
+
+TEST(ProductClassDescriptorTest, ProductsOfAClassShareTheDescriptor)
+{
+    const ProductFactory factory{};
+    const auto first = factory.createProduct("TV", "Sony Bravia", 50.0f);
+    const auto second = factory.createProduct("TV", "LG \"OLED\"", 0.1f);
+    const TV created("Samsung", 42.5f);
+
+    const auto &descriptor = first->descriptor();
+    EXPECT_EQ(&second->descriptor(), &descriptor);
+    EXPECT_EQ(&created.descriptor(), &descriptor);
+    EXPECT_EQ(descriptor.classId, ProductFactory::classId("TV"));
+    EXPECT_EQ(descriptor.className, "TV");
+    EXPECT_EQ(descriptor.flags, first->itemFlags());
+    EXPECT_NE(&factory.createProduct("GlassWare", "Vase", 1.0f)->descriptor(), &descriptor);
+
+    for (const warehouseInterface::IProduct *product : {first.get(), second.get()})
+    {
+        EXPECT_EQ(descriptor.serialize(product->nameView(), product->itemSize()), product->serialize());
+        EXPECT_EQ(picojson::value(descriptor.asJson(product->nameView(), product->itemSize())).serialize(),
+                  product->serialize());
+    }
+    EXPECT_EQ(descriptor.serialize(created.nameView(), created.itemSize()), created.serialize());
+    EXPECT_EQ(&factory.createValue("TV", "LG \"OLED\"", 0.1f).asProduct().descriptor(), &descriptor);
+}
+
+TEST(ProductClassDescriptorTest, SerializesFieldsSortedAfterTheName)
+{
+    auto &descriptors = warehouseInterface::ProductClassDescriptors::instance();
+    const auto classId = warehouseInterface::ProductClassTable::instance().intern("LabelledCrate");
+    picojson::object json{};
+    json["class"] = picojson::value("LabelledCrate");
+    json["zone"] = picojson::value("A");
+    json["name"] = picojson::value("ignored");
+    const auto &descriptor = descriptors.describe(classId, warehouseInterface::ProductLabelFlags::fragile, json);
+
+    EXPECT_EQ(descriptors.find(classId), &descriptor);
+    EXPECT_EQ(descriptor.className, "LabelledCrate");
+    EXPECT_EQ(descriptor.fields.count("name"), 0u);
+    EXPECT_EQ(descriptor.serialize("Crate \"B\"", 2.5f),
+              "{\"class\":\"LabelledCrate\",\"name\":\"Crate \\\"B\\\"\",\"size\":2.5,\"zone\":\"A\"}");
+    EXPECT_EQ(descriptor.serialize("Crate", 2.0f), picojson::value(descriptor.asJson("Crate", 2.0f)).serialize());
+}
+
+}  // namespace warehouse